@@ -0,0 +1,113 @@
+// churn.cpp
+//
+// Compares the epoch and hyaline reclamation schemes of epic::collector
+// under thread churn: waves of short-lived threads register a handle,
+// pin and defer a few functions, and exit, while a number of idle
+// participants stay registered (as the parked threads of a pool would).
+//
+// Under the epoch scheme every advance scans all registered participants;
+// under hyaline a sealed bag only visits the occupied slots once, and is
+// executed by the last participant pinned when it was sealed.
+//
+// For each scheme, the benchmark reports the throughput of deferred
+// functions and how many had not run when the last wave exited.
+//
+// Usage: churn [threads per wave] [idle participants] [waves]
+
+#include <epic/guard.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+constexpr static auto const SUCCESS = 0x0;
+constexpr static auto const FAILURE = 0x1;
+
+// The number of deferred functions each short-lived thread defers.
+constexpr static auto const DEFERS_PER_THREAD = 512ul;
+
+struct result
+{
+    double defers_per_second;
+    unsigned long unexecuted;
+};
+
+// run()
+// Runs `waves` waves of `n_threads` short-lived threads against
+// a collector with the given scheme and `n_idle` idle participants.
+static auto run(epic::scheme s, unsigned n_threads, unsigned n_idle, unsigned waves) -> result
+{
+    auto c        = epic::collector{s};
+    auto executed = std::atomic<unsigned long>{0};
+
+    auto idle = std::vector<epic::local_handle>{};
+    for (auto i = 0u; i < n_idle; ++i)
+    {
+        idle.push_back(c.register_handle());
+    }
+
+    auto worker = [&]()
+    {
+        auto const h = c.register_handle();
+        for (auto i = 0ul; i < DEFERS_PER_THREAD; ++i)
+        {
+            auto g = h.pin();
+            g.defer([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); });
+        }
+    };
+
+    auto const start = std::chrono::steady_clock::now();
+    for (auto w = 0u; w < waves; ++w)
+    {
+        auto threads = std::vector<std::thread>{};
+        for (auto i = 0u; i < n_threads; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    auto const total = static_cast<unsigned long>(waves)*n_threads*DEFERS_PER_THREAD;
+    return result{
+        total / std::chrono::duration<double>(elapsed).count(),
+        total - executed.load()};
+}
+
+int main(int argc, char* argv[])
+{
+    auto const n_threads = (argc > 1) 
+        ? static_cast<unsigned>(std::atoi(argv[1])) 
+        : std::max(1u, std::thread::hardware_concurrency());
+    auto const n_idle = (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : 256u;
+    auto const waves  = (argc > 3) ? static_cast<unsigned>(std::atoi(argv[3])) : 64u;
+
+    if (0 == n_threads || 0 == waves)
+    {
+        std::fprintf(stderr, "usage: %s [threads per wave] [idle participants] [waves]\n", argv[0]);
+        return FAILURE;
+    }
+
+    std::printf("threads per wave = %u, idle participants = %u, waves = %u\n", 
+        n_threads, n_idle, waves);
+
+    auto const epoch = run(epic::scheme::epoch, n_threads, n_idle, waves);
+    std::printf("  epoch:   %12.0f defers/s, unexecuted at exit %lu\n",
+        epoch.defers_per_second, epoch.unexecuted);
+
+    auto const hyaline = run(epic::scheme::hyaline, n_threads, n_idle, waves);
+    std::printf("  hyaline: %12.0f defers/s, unexecuted at exit %lu\n",
+        hyaline.defers_per_second, hyaline.unexecuted);
+
+    return SUCCESS;
+}
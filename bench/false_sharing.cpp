@@ -0,0 +1,194 @@
+// false_sharing.cpp
+//
+// Measures pin/unpin throughput while another thread repeatedly
+// scans the participants and attempts to advance the epoch.
+//
+// The first two runs model the participant state in isolation: one
+// with the per-participant records packed contiguously (the layout
+// before the hot fields were isolated) and one with each record
+// padded to a cache line (the current layout). The final run uses
+// the library itself.
+//
+// Usage: false_sharing [threads] [milliseconds]
+
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+#include <epic/guard.hpp>
+#include <epic/cache_padded.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+constexpr static auto const SUCCESS = 0x0;
+constexpr static auto const FAILURE = 0x1;
+
+using clock_type = std::chrono::steady_clock;
+
+// The state of one participant: the epoch read by the advancing
+// thread, next to counters written only by the owner.
+struct participant
+{
+    std::atomic<unsigned long> epoch{0};
+    unsigned long guard_count{0};
+    unsigned long pin_count{0};
+};
+
+using packed_participant = participant;
+using padded_participant = epic::cache_padded<participant>;
+
+// participant_of()
+// Accessors that hide the padding wrapper.
+static auto participant_of(packed_participant& p) -> participant&
+{
+    return p;
+}
+
+static auto participant_of(padded_participant& p) -> participant&
+{
+    return *p;
+}
+
+// run_model()
+// Runs `n_threads` pinning threads and one advancing thread over
+// participants laid out as `Slot`, and returns pins per second.
+template <typename Slot>
+static auto run_model(unsigned n_threads, std::chrono::milliseconds duration) -> double
+{
+    auto slots        = std::vector<Slot>(n_threads);
+    auto global_epoch = epic::cache_padded<std::atomic<unsigned long>>{2ul};
+    auto running      = std::atomic_bool{true};
+    auto total        = std::atomic<unsigned long>{0};
+
+    auto pinner = [&](unsigned const index)
+    {
+        auto& p = participant_of(slots[index]);
+        auto pins = 0ul;
+        while (running.load(std::memory_order_relaxed))
+        {
+            // Pin: publish the global epoch, marked as pinned.
+            p.guard_count += 1;
+            p.epoch.store(global_epoch->load(std::memory_order_relaxed) | 1, 
+                std::memory_order_seq_cst);
+            p.pin_count += 1;
+
+            // Unpin.
+            p.guard_count -= 1;
+            p.epoch.store(0, std::memory_order_release);
+            ++pins;
+        }
+
+        total.fetch_add(pins, std::memory_order_relaxed);
+    };
+
+    auto advancer = [&]()
+    {
+        while (running.load(std::memory_order_relaxed))
+        {
+            auto const ge = global_epoch->load(std::memory_order_relaxed);
+            auto broken = false;
+            for (auto& s : slots)
+            {
+                auto const le = participant_of(s).epoch.load(std::memory_order_acquire);
+                broken |= (0 != (le & 1)) && ((le & ~1ul) != ge);
+            }
+
+            if (!broken)
+            {
+                auto expected = ge;
+                global_epoch->compare_exchange_strong(expected, ge + 2);
+            }
+        }
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0u; i < n_threads; ++i)
+    {
+        threads.emplace_back(pinner, i);
+    }
+    threads.emplace_back(advancer);
+
+    std::this_thread::sleep_for(duration);
+    running.store(false);
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    return total.load() / std::chrono::duration<double>(duration).count();
+}
+
+// run_library()
+// Runs `n_threads` threads pinning participants of an epic::collector,
+// deferring a no-op now and then so that collection (and with it, epoch
+// advancement) is triggered, and returns pins per second.
+static auto run_library(unsigned n_threads, std::chrono::milliseconds duration) -> double
+{
+    auto c       = epic::collector{};
+    auto running = std::atomic_bool{true};
+    auto total   = std::atomic<unsigned long>{0};
+
+    auto pinner = [&]()
+    {
+        auto const h = c.register_handle();
+        auto pins = 0ul;
+        while (running.load(std::memory_order_relaxed))
+        {
+            auto g = h.pin();
+            if (0 == (pins & 63))
+            {
+                g.defer([]{});
+            }
+            ++pins;
+        }
+
+        total.fetch_add(pins, std::memory_order_relaxed);
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0u; i < n_threads; ++i)
+    {
+        threads.emplace_back(pinner);
+    }
+
+    std::this_thread::sleep_for(duration);
+    running.store(false);
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    return total.load() / std::chrono::duration<double>(duration).count();
+}
+
+int main(int argc, char* argv[])
+{
+    auto const n_threads = (argc > 1) 
+        ? static_cast<unsigned>(std::atoi(argv[1])) 
+        : std::max(1u, std::thread::hardware_concurrency() - 1);
+    auto const duration = std::chrono::milliseconds{
+        (argc > 2) ? std::atoi(argv[2]) : 1000};
+
+    if (0 == n_threads || duration.count() <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [threads] [milliseconds]\n", argv[0]);
+        return FAILURE;
+    }
+
+    std::printf("threads = %u, duration = %lld ms\n", 
+        n_threads, static_cast<long long>(duration.count()));
+
+    std::printf("packed participants: %12.0f pins/s\n", 
+        run_model<packed_participant>(n_threads, duration));
+    std::printf("padded participants: %12.0f pins/s\n", 
+        run_model<padded_participant>(n_threads, duration));
+    std::printf("epic::collector:     %12.0f pins/s\n", 
+        run_library(n_threads, duration));
+
+    return SUCCESS;
+}
@@ -0,0 +1,224 @@
+// reclamation.cpp
+//
+// Runs one Treiber stack, written once against the guard API, under
+// epoch-based reclamation (epic::collector, which frees a bag once
+// bag::is_expired()), hazard pointers (epic::hp_collector), and
+// interval-based reclamation (epic::ibr_collector).
+//
+// Each thread repeatedly pushes and pops under a fresh guard. For each
+// scheme, the benchmark reports the throughput and the peak number of
+// popped nodes that were not yet reclaimed. In the second run one
+// extra reader holds a guard for the whole run; under epoch-based
+// reclamation that keeps every popped node alive; under hazard
+// pointers it holds back only the nodes it protects, and under
+// interval-based reclamation only the nodes born before its last load.
+//
+// Usage: reclamation [threads] [milliseconds]
+
+#include <epic/atomic.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+#include <epic/hp_collector.hpp>
+#include <epic/ibr_collector.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+constexpr static auto const SUCCESS = 0x0;
+constexpr static auto const FAILURE = 0x1;
+
+// The number of nodes popped but not yet destroyed.
+static std::atomic<long> retired_nodes{0};
+
+// Nodes carry their birth era for interval-based reclamation;
+// the other schemes ignore it.
+struct node : epic::era_stamped
+{
+    unsigned long value;
+    epic::atomic<node> next;
+
+    explicit node(unsigned long value_)
+        : value{value_}
+        , next{epic::atomic<node>::null()} {}
+
+    ~node()
+    {
+        retired_nodes.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+template <typename Collector>
+class stack
+{
+    epic::atomic<node> head;
+
+public:
+    stack() : head{epic::atomic<node>::null()} {}
+
+    ~stack()
+    {
+        auto g = Collector::guard_type::unprotected();
+        while (pop(g)) {}
+    }
+
+    template <typename Guard>
+    auto push(unsigned long value, Guard& g) -> void
+    {
+        auto n = epic::shared<node>::from_usize(epic::pointable<node>::init(value));
+        for (;;)
+        {
+            auto top = head.load(std::memory_order_relaxed, g);
+            n->next.store(top.clone(), std::memory_order_relaxed);
+            if (head.compare_and_set_weak(top, n, std::memory_order_release, g))
+            {
+                return;
+            }
+        }
+    }
+
+    template <typename Guard>
+    auto pop(Guard& g) -> bool
+    {
+        for (;;)
+        {
+            auto top = head.load(std::memory_order_acquire, g);
+            if (top.is_null())
+            {
+                return false;
+            }
+
+            auto next = top->next.load(std::memory_order_relaxed, g);
+            if (head.compare_and_set_weak(top, next, std::memory_order_acq_rel, g))
+            {
+                retired_nodes.fetch_add(1, std::memory_order_relaxed);
+                g.defer_destroy(top.clone());
+                return true;
+            }
+        }
+    }
+
+    template <typename Guard>
+    auto peek(Guard& g) -> unsigned long
+    {
+        auto top = head.load(std::memory_order_acquire, g);
+        return top.is_null() ? 0 : top->value;
+    }
+};
+
+struct result
+{
+    double ops_per_second;
+    long   peak_retired;
+};
+
+// run()
+// Runs `n_threads` threads pushing and popping on a stack under
+// `Collector`, optionally alongside a reader that stays pinned.
+template <typename Collector>
+static auto run(unsigned n_threads, std::chrono::milliseconds duration, bool stalled_reader) -> result
+{
+    auto c       = Collector{};
+    auto s       = stack<Collector>{};
+    auto running = std::atomic_bool{true};
+    auto total   = std::atomic<unsigned long>{0};
+    auto peak    = std::atomic<long>{0};
+
+    retired_nodes.store(0);
+
+    auto worker = [&]()
+    {
+        auto const h = c.register_handle();
+        auto ops = 0ul;
+        while (running.load(std::memory_order_relaxed))
+        {
+            auto g = h.pin();
+            s.push(ops, g);
+            s.pop(g);
+            ops += 2;
+
+            auto const r = retired_nodes.load(std::memory_order_relaxed);
+            if (r > peak.load(std::memory_order_relaxed))
+            {
+                peak.store(r, std::memory_order_relaxed);
+            }
+        }
+
+        total.fetch_add(ops, std::memory_order_relaxed);
+    };
+
+    auto reader = [&]()
+    {
+        auto const h = c.register_handle();
+        auto g = h.pin();
+        s.peek(g);
+        while (running.load(std::memory_order_relaxed))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0u; i < n_threads; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+
+    if (stalled_reader)
+    {
+        threads.emplace_back(reader);
+    }
+
+    std::this_thread::sleep_for(duration);
+    running.store(false);
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    return result{
+        total.load() / std::chrono::duration<double>(duration).count(),
+        peak.load()};
+}
+
+int main(int argc, char* argv[])
+{
+    auto const n_threads = (argc > 1) 
+        ? static_cast<unsigned>(std::atoi(argv[1])) 
+        : std::max(1u, std::thread::hardware_concurrency());
+    auto const duration = std::chrono::milliseconds{
+        (argc > 2) ? std::atoi(argv[2]) : 1000};
+
+    if (0 == n_threads || duration.count() <= 0)
+    {
+        std::fprintf(stderr, "usage: %s [threads] [milliseconds]\n", argv[0]);
+        return FAILURE;
+    }
+
+    std::printf("threads = %u, duration = %lld ms\n", 
+        n_threads, static_cast<long long>(duration.count()));
+
+    for (auto const stalled : {false, true})
+    {
+        std::printf("%s\n", stalled ? "with a stalled reader:" : "without a stalled reader:");
+
+        auto const ebr = run<epic::collector>(n_threads, duration, stalled);
+        std::printf("  epoch-based:     %12.0f ops/s, peak unreclaimed %ld\n",
+            ebr.ops_per_second, ebr.peak_retired);
+
+        auto const hp = run<epic::hp_collector>(n_threads, duration, stalled);
+        std::printf("  hazard pointers: %12.0f ops/s, peak unreclaimed %ld\n",
+            hp.ops_per_second, hp.peak_retired);
+
+        auto const ibr = run<epic::ibr_collector>(n_threads, duration, stalled);
+        std::printf("  interval-based:  %12.0f ops/s, peak unreclaimed %ld\n",
+            ibr.ops_per_second, ibr.peak_retired);
+    }
+
+    return SUCCESS;
+}
@@ -0,0 +1,265 @@
+// async_guard.hpp
+
+#ifndef EPIC_ASYNC_GUARD_H
+#define EPIC_ASYNC_GUARD_H
+
+#include <atomic>
+#include <utility>
+#include <optional>
+#include <type_traits>
+
+#include "guard.hpp"
+#include "default.hpp"
+#include "local_handle.hpp"
+
+// unpinned() detects awaiters with a requires-expression, so it needs
+// concepts as well as coroutines.
+#if defined(__cpp_impl_coroutine) && defined(__cpp_concepts) && __has_include(<coroutine>)
+#include <coroutine>
+#define EPIC_COROUTINES 1
+#endif
+
+namespace epic
+{
+    // epic::handle_source
+    //
+    // Returns the calling thread's handle to a collector; the handle
+    // must remain valid until the thread exits. epic::default_handle()
+    // is the handle source of the default collector.
+    using handle_source = local_handle const& (*)();
+
+    // epic::async_guard
+    //
+    // A guard for code that suspends and may resume on another thread,
+    // such as a C++20 coroutine.
+    //
+    // An `epic::guard` is tied to the participant of the thread that
+    // pinned it. An `async_guard` is not: it pins through the handle of
+    // whichever thread (re)pins it, as returned by its handle source, and
+    // unpins at every suspension, so a suspended coroutine holds back
+    // neither the epoch nor the participant of the thread it left.
+    //
+    // Validity
+    //
+    // A `shared<T>` loaded under an async_guard is valid until the guard
+    // is next suspended, and not after: the object may be reclaimed while
+    // the coroutine is suspended. To use an object on both sides of a
+    // suspension, look it up again on resume (see epic::async_lookup), or
+    // keep a key rather than the pointer. The generation() of the guard
+    // counts suspensions, to tell whether a pointer is still current.
+    //
+    // The guard may be moved to another thread only while it is suspended.
+    class async_guard
+    {
+        handle_source source;
+
+        // The guard of the thread currently running; a dummy while suspended.
+        guard pinned;
+
+        // The number of suspensions so far.
+        usize_t suspensions;
+
+    public:
+        // Pins the calling thread through `source_`.
+        explicit async_guard(handle_source source_ = &default_handle);
+
+        async_guard(async_guard const&)            = delete;
+        async_guard& operator=(async_guard const&) = delete;
+
+        async_guard(async_guard&& g);
+        async_guard& operator=(async_guard&& g);
+
+        // async_guard::suspend()
+        // Unpins before a suspension point; every `shared<T>` loaded
+        // so far is invalidated.
+        auto suspend() -> void;
+
+        // async_guard::resume()
+        // Pins the calling thread again after a suspension point;
+        // it need not be the thread that suspended.
+        auto resume() -> void;
+
+        // async_guard::is_suspended()
+        auto is_suspended() const noexcept -> bool;
+
+        // async_guard::generation()
+        // Returns the number of times the guard has been suspended.
+        auto generation() const noexcept -> usize_t;
+
+        // async_guard::get()
+        // Returns the guard of the thread currently running, for the
+        // operations not forwarded below. Must not be suspended.
+        auto get() -> guard&;
+
+        // async_guard::protect()
+        // Loads the tagged pointer stored in `src`; used by atomic<T>::load().
+        auto protect(atomic_usize_t const& src, std::memory_order order,
+            usize_t const tag_mask) const noexcept -> usize_t
+        {
+            return pinned.protect(src, order, tag_mask);
+        }
+
+        // async_guard::defer()
+        // See guard::defer().
+        template <typename F>
+        auto defer(F&& f, usize_t bytes = 0) -> defer_status
+        {
+            return get().defer(std::forward<F>(f), bytes);
+        }
+
+        // async_guard::defer_destroy()
+        // See guard::defer_destroy().
+        template <typename T>
+        auto defer_destroy(shared<T>&& ptr, usize_t bytes = 0) -> defer_status
+        {
+            return get().defer_destroy(std::move(ptr), bytes);
+        }
+
+        // async_guard::flush()
+        // See guard::flush().
+        auto flush() -> void;
+    };
+
+    // epic::async_lookup
+    //
+    // A lookup that is split across suspension points.
+    //
+    // Wraps a callable `find` that performs the lookup under a guard (e.g.
+    // a search of a lock-free structure) and returns the result, typically
+    // a `shared<T>` or an optional one. Invoking the async_lookup returns
+    // the cached result while the async_guard has not been suspended since
+    // it was computed, and repeats the lookup otherwise. The result may
+    // differ (or be gone) after a suspension; callers must handle that.
+    template <typename Find>
+    class async_lookup
+    {
+        using result_type = std::invoke_result_t<Find&, guard&>;
+
+        Find find;
+
+        std::optional<result_type> cached;
+
+        // The generation of the guard when `cached` was computed.
+        usize_t computed_in;
+
+    public:
+        explicit async_lookup(Find find_)
+            : find{std::move(find_)}
+            , cached{}
+            , computed_in{0} {}
+
+        // async_lookup::operator()
+        // Returns the result of the lookup, valid under `g` until it is
+        // next suspended.
+        auto operator()(async_guard& g) -> result_type&
+        {
+            if (!cached.has_value() || computed_in != g.generation())
+            {
+                cached.reset();
+
+                // shared<T> is copyable but not movable.
+                auto result = find(g.get());
+                if constexpr (std::is_copy_constructible_v<result_type>)
+                {
+                    cached.emplace(result);
+                }
+                else
+                {
+                    cached.emplace(std::move(result));
+                }
+
+                computed_in = g.generation();
+            }
+
+            return *cached;
+        }
+
+        // async_lookup::is_stale()
+        // Returns `true` if the lookup must be repeated under `g`.
+        auto is_stale(async_guard const& g) const noexcept -> bool
+        {
+            return !cached.has_value() || computed_in != g.generation();
+        }
+    };
+
+#if defined(EPIC_COROUTINES)
+
+    // epic::unpinned_awaiter
+    //
+    // The awaiter returned by epic::unpinned().
+    template <typename Awaitable>
+    class unpinned_awaiter
+    {
+        // Returns the awaiter of `a`: the result of its operator co_await,
+        // if it has one, and otherwise `a` itself.
+        static auto awaiter_of(std::remove_reference_t<Awaitable>& a) -> decltype(auto)
+        {
+            if constexpr (requires { a.operator co_await(); })
+            {
+                return a.operator co_await();
+            }
+            else
+            {
+                return static_cast<std::remove_reference_t<Awaitable>&>(a);
+            }
+        }
+
+        using awaiter_type = decltype(awaiter_of(std::declval<std::remove_reference_t<Awaitable>&>()));
+
+        async_guard& g;
+        Awaitable inner;
+        awaiter_type awaiter;
+
+    public:
+        unpinned_awaiter(async_guard& g_, Awaitable&& inner_)
+            : g{g_}
+            , inner{std::forward<Awaitable>(inner_)}
+            , awaiter{awaiter_of(inner)} {}
+
+        // The awaiter may refer to `inner`; it is never moved.
+        unpinned_awaiter(unpinned_awaiter const&)            = delete;
+        unpinned_awaiter& operator=(unpinned_awaiter const&) = delete;
+
+        auto await_ready() -> bool
+        {
+            return awaiter.await_ready();
+        }
+
+        template <typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> h) -> decltype(auto)
+        {
+            // Unpin first: once the wrapped awaiter has been handed the
+            // coroutine, it may resume on another thread at any moment.
+            g.suspend();
+            return awaiter.await_suspend(h);
+        }
+
+        auto await_resume() -> decltype(auto)
+        {
+            if (g.is_suspended())
+            {
+                g.resume();
+            }
+
+            return awaiter.await_resume();
+        }
+    };
+
+    // epic::unpinned()
+    // Wraps `awaitable` so that `g` is unpinned while the coroutine is
+    // suspended on it, and pinned on the resuming thread afterwards:
+    //
+    //     auto g = epic::async_guard{};
+    //     auto node = lookup(g);
+    //     co_await epic::unpinned(g, socket.read(buffer));
+    //     // `node` is invalid here; look it up again
+    template <typename Awaitable>
+    auto unpinned(async_guard& g, Awaitable&& awaitable) -> unpinned_awaiter<Awaitable>
+    {
+        return unpinned_awaiter<Awaitable>{g, std::forward<Awaitable>(awaitable)};
+    }
+
+#endif // EPIC_COROUTINES
+}
+
+#endif // EPIC_ASYNC_GUARD_H
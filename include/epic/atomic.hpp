@@ -25,7 +25,9 @@ namespace epic
     // be stored in the least significant bits of the addres. For example,
     // the tag for a pointer to a sized type T should be less than:
     // 
-    // Any method that loads the pointer must be passed a reference to an epic::guard.
+    // Any method that loads the pointer must be passed a reference to a guard:
+    // an epic::guard, an epic::hp_guard under hazard-pointer reclamation, or
+    // an epic::ibr_guard under interval-based reclamation.
     template <typename T>
     class atomic
     {
@@ -134,9 +136,15 @@ namespace epic
         //
         // This function takes an ordering argument that describes
         // the memory ordering for the load operation.
-        auto load(std::memory_order order, guard& g) -> shared<T>
+        //
+        // The guard determines how the pointee is protected: an epic::guard
+        // protects every load by keeping the thread pinned, while an
+        // epic::hp_guard publishes a hazard pointer for the loaded pointer,
+        // and an epic::ibr_guard extends its reserved interval of eras.
+        template <typename G>
+        auto load(std::memory_order order, G& g) -> shared<T>
         {   
-            auto const l = std::atomic_load_explicit(&this->data, order);
+            auto const l = g.protect(this->data, order, low_bits<T>());
             return shared<T>::from_usize(l);
         }
 
@@ -163,7 +171,8 @@ namespace epic
         // atomic::swap(shared<T>)
         // Stores a `shared` pointer into the atomic pointer, returning the 
         // previous pointer as a `shared`.
-        auto swap(shared<T> new_ptr, std::memory_order order, guard& g) -> shared<T>
+        template <typename G>
+        auto swap(shared<T> new_ptr, std::memory_order order, G& g) -> shared<T>
         {
             auto const prev = std::atomic_exchange_explicit(&this->data, new_ptr.into_usize(), order);
             return shared<T>::from_usize(prev);
@@ -172,7 +181,8 @@ namespace epic
         // atomic::swap(owned<T>)
         // Stores an `owned` pointer into the atomic pointer, returning the
         // previous pointer as a `shared`.
-        auto swap(owned<T> new_ptr, std::memory_order order, guard& g) -> shared<T>
+        template <typename G>
+        auto swap(owned<T> new_ptr, std::memory_order order, G& g) -> shared<T>
         {
             auto const prev = std::atomic_exchange_explicit(&this->data, new_ptr.into_usize(), order);
             return shared<T>::from_usize(prev);
@@ -183,24 +193,26 @@ namespace epic
         // value of the pointer is the same as `current`. The tag of the pointer
         // is also taken into account, so two pointers to the same object but
         // with distinct tags will not be considered equal.
+        template <typename G>
         auto compare_and_set(
             shared<T> current, 
             shared<T> next, 
             std::memory_order order, 
-            guard& g) -> optional_shared<T>
+            G& g) -> optional_shared<T>
         {   
-            auto const curr_raw = current.into_usize();
+            auto curr_raw = current.into_usize();
             auto const next_raw = next.into_usize();    
             auto const exchanged = std::atomic_compare_exchange_strong_explicit(
                 &this->data, 
-                curr_raw, 
+                &curr_raw, 
                 next_raw, 
                 ordering_success(order), 
                 ordering_failure(order));
 
             if (exchanged)
             {
-                return std::make_optional<shared<T>>(shared<T>::from_usize(next_raw));
+                auto const exchanged_ptr = shared<T>::from_usize(next_raw);
+                return optional_shared<T>{std::in_place, exchanged_ptr};
             }
 
             // failed to perform the exchange
@@ -212,17 +224,18 @@ namespace epic
         // value of the pointer is the same as `current`. The tag of the pointer
         // is also taken into account, so two pointers to the same object but
         // with distinct tags will not be considered equal.
+        template <typename G>
         auto compare_and_set(
             shared<T> current, 
             owned<T> next, 
             std::memory_order order, 
-            guard& g) -> optional_shared<T>
+            G& g) -> optional_shared<T>
         {   
-            auto const curr_raw = current.into_usize();
+            auto curr_raw = current.into_usize();
             auto const next_raw = next.into_usize();    
             auto const exchanged = std::atomic_compare_exchange_strong_explicit(
                 &this->data, 
-                curr_raw, 
+                &curr_raw, 
                 next_raw, 
                 ordering_success(order), 
                 ordering_failure(order));
@@ -243,24 +256,26 @@ namespace epic
         // with distinct tags will not be considered equal.
         //
         // Unlike atomic::compare_and_set(), this function is allowed to spuriously fail.
+        template <typename G>
         auto compare_and_set_weak(
             shared<T> current, 
             shared<T> next, 
             std::memory_order order, 
-            guard& g) -> optional_shared<T>
+            G& g) -> optional_shared<T>
         {   
-            auto const curr_raw = current.into_usize();
+            auto curr_raw = current.into_usize();
             auto const next_raw = next.into_usize();    
             auto const exchanged = std::atomic_compare_exchange_weak_explicit(
                 &this->data, 
-                curr_raw, 
+                &curr_raw, 
                 next_raw, 
                 ordering_success(order), 
                 ordering_failure(order));
 
             if (exchanged)
             {
-                return std::make_optional<shared<T>>(shared<T>::from_usize(next_raw));
+                auto const exchanged_ptr = shared<T>::from_usize(next_raw);
+                return optional_shared<T>{std::in_place, exchanged_ptr};
             }
 
             // failed to perform the exchange
@@ -274,17 +289,18 @@ namespace epic
         // with distinct tags will not be considered equal.
         //
         // Unlike atomic::compare_and_set(), this function is allowed to spuriously fail.
+        template <typename G>
         auto compare_and_set_weak(
             shared<T> current, 
             owned<T> next, 
             std::memory_order order, 
-            guard& g) -> optional_shared<T>
+            G& g) -> optional_shared<T>
         {   
-            auto const curr_raw = current.into_usize();
+            auto curr_raw = current.into_usize();
             auto const next_raw = next.into_usize();    
             auto const exchanged = std::atomic_compare_exchange_weak_explicit(
                 &this->data, 
-                curr_raw, 
+                &curr_raw, 
                 next_raw, 
                 ordering_success(order), 
                 ordering_failure(order));
@@ -301,7 +317,8 @@ namespace epic
         // atomic::fetch_and()
         // Performs a bitwise "and" operation on the current tag and the argument `value`
         // and sets the new tag to the result. Returns the previous pointer as `shared`.
-        auto fetch_and(size_t value, std::memory_order order, guard& g) -> shared<T>
+        template <typename G>
+        auto fetch_and(size_t value, std::memory_order order, G& g) -> shared<T>
         {
             auto const res = (value | ~low_bits<T>());
             auto const prev = std::atomic_fetch_and_explicit(&this->data, res, order);
@@ -311,7 +328,8 @@ namespace epic
         // atomic::fetch_or()
         // Performs bitwise "or" operation on the current tag and the argument `value`
         // and sets the new tag to the result. Returns the previous pointer as `shared`.
-        auto fetch_or(size_t value, std::memory_order order, guard& g) -> shared<T>
+        template <typename G>
+        auto fetch_or(size_t value, std::memory_order order, G& g) -> shared<T>
         {
             auto const res = (value & low_bits<T>());
             auto const prev = std::atomic_fetch_or_explicit(&this->data, res, order);
@@ -321,7 +339,8 @@ namespace epic
         // atomic::fetch_xor()
         // Performs bitwise "xor" operaton on the current tag and the argument `value`
         // and sets the new tag to the result. Returns the previous pointer as `shared`.
-        auto fetch_xor(size_t value, std::memory_order order, guard& g) -> shared<T>
+        template <typename G>
+        auto fetch_xor(size_t value, std::memory_order order, G& g) -> shared<T>
         {
             auto const res = (value & low_bits<T>());
             auto const prev = std::atomic_fetch_xor_explicit(&this->data, res, order);
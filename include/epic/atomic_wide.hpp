@@ -0,0 +1,528 @@
+// atomic_wide.hpp
+
+#ifndef EPIC_ATOMIC_WIDE_H
+#define EPIC_ATOMIC_WIDE_H
+
+#include <atomic>
+#include <cstring>
+#include <optional>
+
+#include "base.hpp"
+#include "owned.hpp"
+#include "shared.hpp"
+#include "pointer.hpp"
+#include "ordering.hpp"
+#include "type_alias.hpp"
+
+namespace epic
+{
+    // epic::wide_value
+    //
+    // A pointer and its version counter, as read from or written to
+    // an epic::wide_word in a single double-width operation.
+    struct wide_value
+    {
+        usize_t ptr;
+        usize_t version;
+    };
+
+    // epic::wide_word
+    //
+    // Two adjacent words updated together by a double-width CAS.
+    //
+    // Each half is also an atomic word of its own, so that a guard can
+    // protect the pointer half alone (see atomic_wide::load()) and the
+    // tag bits can be updated with a single-width read-modify-write.
+    struct alignas(2*sizeof(usize_t)) wide_word
+    {
+        atomic_usize_t ptr;
+        atomic_usize_t version;
+
+        wide_word(usize_t ptr_, usize_t version_)
+            : ptr{ptr_}, version{version_} {}
+    };
+
+    // The double-width operations below work on two 64-bit words.
+    static_assert(sizeof(usize_t) == 8);
+    static_assert(sizeof(wide_word) == 2*sizeof(usize_t));
+
+#if defined(__x86_64__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+
+    // wide_is_always_lock_free
+    // The earliest x86-64 processors lack `cmpxchg16b`, so it is only used
+    // when the target guarantees it: with -mcx16 or -march=x86-64-v2 and
+    // later (see EPIC_CX16), which define __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16.
+    constexpr static bool const wide_is_always_lock_free = true;
+
+    // wide_cas()
+    // Replaces the contents of `dst` with `desired` if they equal `expected`;
+    // otherwise stores the current contents in `expected`. `lock cmpxchg16b`
+    // is a full barrier, so every memory order is satisfied.
+    inline auto wide_cas(
+        wide_word& dst,
+        wide_value& expected,
+        wide_value const desired,
+        std::memory_order) noexcept -> bool
+    {
+        bool exchanged;
+        __asm__ __volatile__(
+            "lock cmpxchg16b %1"
+            : "=@ccz"(exchanged), "+m"(dst), "+a"(expected.ptr), "+d"(expected.version)
+            : "b"(desired.ptr), "c"(desired.version)
+            : "memory");
+        return exchanged;
+    }
+
+    // wide_load()
+    // Reads both halves of `src` at once. x86-64 has no double-width load,
+    // so this is a CAS that writes back the value it compares equal to;
+    // the contents of `src` never change.
+    inline auto wide_load(wide_word const& src, std::memory_order order) noexcept -> wide_value
+    {
+        auto current = wide_value{0, 0};
+        wide_cas(const_cast<wide_word&>(src), current, current, order);
+        return current;
+    }
+
+#else
+
+    // Elsewhere the compiler (or libatomic) provides the double-width CAS;
+    // it is lock-free only where the target guarantees the instruction.
+    // Otherwise libatomic serializes it with a lock, and atomic_wide must
+    // not touch either half with a single-width atomic.
+    using wide_bits = unsigned __int128;
+
+    static_assert(sizeof(wide_value) == sizeof(wide_bits));
+    static_assert(sizeof(wide_word) == sizeof(wide_bits));
+
+    constexpr static bool const wide_is_always_lock_free = __atomic_always_lock_free(sizeof(wide_bits), 0);
+
+    inline auto wide_cas(
+        wide_word& dst,
+        wide_value& expected,
+        wide_value const desired,
+        std::memory_order order) noexcept -> bool
+    {
+        auto expected_bits = wide_bits{};
+        auto desired_bits  = wide_bits{};
+        std::memcpy(&expected_bits, &expected, sizeof(wide_bits));
+        std::memcpy(&desired_bits, &desired, sizeof(wide_bits));
+
+        auto const exchanged = __atomic_compare_exchange_n(
+            reinterpret_cast<wide_bits*>(&dst),
+            &expected_bits,
+            desired_bits,
+            false,
+            static_cast<int>(ordering_success(order)),
+            static_cast<int>(ordering_failure(order)));
+
+        std::memcpy(&expected, &expected_bits, sizeof(wide_bits));
+        return exchanged;
+    }
+
+    inline auto wide_load(wide_word const& src, std::memory_order order) noexcept -> wide_value
+    {
+        auto const bits = __atomic_load_n(reinterpret_cast<wide_bits const*>(&src), static_cast<int>(order));
+
+        auto current = wide_value{};
+        std::memcpy(&current, &bits, sizeof(wide_bits));
+        return current;
+    }
+
+#endif
+
+    // epic::versioned
+    //
+    // A pointer loaded from an atomic_wide, and the version it had.
+    template <typename T>
+    struct versioned
+    {
+        shared<T> ptr;
+        usize_t version;
+    };
+
+    template <typename T>
+    using optional_versioned = std::optional<versioned<T>>;
+
+    // An atomic pointer paired with a version counter.
+    //
+    // Every store, swap and successful compare-and-set increments the
+    // version, and a compare-and-set compares the pointer and the version
+    // together in a single double-width CAS (`cmpxchg16b` on x86-64 with EPIC_CX16). A
+    // pointer that is removed and reinstalled therefore does not compare
+    // equal to a stale snapshot, which makes the ABA problem a non-issue
+    // for free lists and pointer+counter snapshots.
+    //
+    // As with epic::atomic, the low bits of the pointer hold a tag, and
+    // any method that loads the pointer must be passed a guard.
+    template <typename T>
+    class atomic_wide
+    {
+        wide_word data;
+
+    public:
+        // Is the double-width CAS lock-free on this platform?
+        constexpr static bool const is_always_lock_free = wide_is_always_lock_free;
+
+        atomic_wide()  = delete;
+        ~atomic_wide() = default;
+
+        atomic_wide(atomic_wide const&)            = delete;
+        atomic_wide& operator=(atomic_wide const&) = delete;
+
+        atomic_wide(atomic_wide&& a)
+            : data{a.data.ptr.load(std::memory_order_acquire), a.data.version.load(std::memory_order_acquire)} {}
+
+        atomic_wide& operator=(atomic_wide&& a)
+        {
+            if (&a != this)
+            {
+                auto const val = wide_load(a.data, std::memory_order_acquire);
+                auto expected  = wide_load(this->data, std::memory_order_relaxed);
+                while (!wide_cas(this->data, expected, val, std::memory_order_release)) {}
+                a.data.ptr.store(0, std::memory_order_release);
+            }
+
+            return *this;
+        }
+
+        // atomic_wide::make()
+        // Constructs a new pointee on the heap and returns a new atomic pointer to it.
+        template <typename... Args>
+        static auto make(Args&&... args) -> atomic_wide<T>
+        {
+            auto const r = pointable<T>::init(std::forward<Args>(args)...);
+            return atomic_wide<T>::from_usize(r);
+        }
+
+        // atomic_wide::null()
+        // Returns a new null atomic pointer.
+        static auto null() -> atomic_wide<T>
+        {
+            return atomic_wide<T>{0};
+        }
+
+        // atomic_wide::from_usize()
+        // Returns a new atomic pointer pointing to tagged pointer `data`, at version 0.
+        static auto from_usize(size_t data) -> atomic_wide<T>
+        {
+            return atomic_wide<T>{data};
+        }
+
+        // atomic_wide::from_shared()
+        // Constructs a new `atomic_wide` instance from a `shared` instance.
+        static auto from_shared(shared<T>&& s) -> atomic_wide<T>
+        {
+            return atomic_wide<T>::from_usize(s.into_usize());
+        }
+
+        // atomic_wide::from_owned()
+        // Constructs a new `atomic_wide` instance from an `owned` instance.
+        static auto from_owned(owned<T>&& o) -> atomic_wide<T>
+        {
+            return atomic_wide<T>::from_usize(owned<T>::into_usize(std::move(o)));
+        }
+
+        // atomic_wide::into_owned()
+        // Takes ownership of the pointee; see atomic::into_owned().
+        auto into_owned() -> owned<T>
+        {
+            return owned<T>::from_usize(ptr_relaxed());
+        }
+
+        // atomic_wide::load()
+        // Loads the pointer and its version.
+        //
+        // The guard protects the pointer half as it would for atomic<T>;
+        // the version is then read together with a pointer equal to the
+        // protected one, so the pair is consistent and the pointee is
+        // protected. Under an epic::guard the protection is a plain load.
+        // The single-width read of the pointer half is only trusted once
+        // the double-width load confirms it, so this holds whether or not
+        // the double-width operations are lock-free.
+        template <typename G>
+        auto load(std::memory_order order, G& g) -> versioned<T>
+        {
+            for (;;)
+            {
+                auto const p = g.protect(this->data.ptr, order, low_bits<T>());
+                auto const w = wide_load(this->data, order);
+                if (w.ptr == p)
+                {
+                    return versioned<T>{shared<T>::from_usize(w.ptr), w.version};
+                }
+            }
+        }
+
+        // atomic_wide::version()
+        // Returns the current version, without loading the pointer.
+        auto version(std::memory_order order) const -> usize_t
+        {
+            if constexpr (is_always_lock_free)
+            {
+                return this->data.version.load(order);
+            }
+            else
+            {
+                return wide_load(this->data, order).version;
+            }
+        }
+
+        // atomic_wide::store(shared<T>)
+        // Stores the pointer managed by `new_ptr` and increments the version.
+        //
+        // Consumes the `shared` instance.
+        auto store(shared<T>&& new_ptr, std::memory_order order) -> void
+        {
+            exchange(new_ptr.into_usize(), order);
+        }
+
+        // atomic_wide::store(owned<T>)
+        // Stores the pointer managed by `new_ptr` and increments the version.
+        //
+        // Consumes the `owned` instance.
+        auto store(owned<T>&& new_ptr, std::memory_order order) -> void
+        {
+            exchange(owned<T>::into_usize(std::move(new_ptr)), order);
+        }
+
+        // atomic_wide::swap(shared<T>)
+        // Stores a `shared` pointer and increments the version, returning
+        // the previous pointer and version.
+        template <typename G>
+        auto swap(shared<T> new_ptr, std::memory_order order, G&) -> versioned<T>
+        {
+            auto const prev = exchange(new_ptr.into_usize(), order);
+            return versioned<T>{shared<T>::from_usize(prev.ptr), prev.version};
+        }
+
+        // atomic_wide::swap(owned<T>)
+        // Stores an `owned` pointer and increments the version, returning
+        // the previous pointer and version.
+        template <typename G>
+        auto swap(owned<T> new_ptr, std::memory_order order, G&) -> versioned<T>
+        {
+            auto const prev = exchange(owned<T>::into_usize(std::move(new_ptr)), order);
+            return versioned<T>{shared<T>::from_usize(prev.ptr), prev.version};
+        }
+
+        // atomic_wide::compare_and_set(shared<T>)
+        // Stores the pointer `next` at version `current.version + 1` if both
+        // the pointer (including its tag) and the version are unchanged
+        // since `current` was loaded. Returns the new pointer and version.
+        template <typename G>
+        auto compare_and_set(
+            versioned<T> current,
+            shared<T> next,
+            std::memory_order order,
+            G&) -> optional_versioned<T>
+        {
+            return compare_and_set_raw(current, next.into_usize(), order);
+        }
+
+        // atomic_wide::compare_and_set(owned<T>)
+        // As above; on success the `owned` pointee is now shared and `next`
+        // is consumed. On failure `next` keeps its pointee, so the caller
+        // may retry with it or let it drop.
+        template <typename G>
+        auto compare_and_set(
+            versioned<T> current,
+            owned<T>&& next,
+            std::memory_order order,
+            G&) -> optional_versioned<T>
+        {
+            auto const next_raw = owned<T>::into_usize(std::move(next));
+            auto result = compare_and_set_raw(current, next_raw, order);
+            if (!result)
+            {
+                next = owned<T>::from_usize(next_raw);
+            }
+
+            return result;
+        }
+
+        // atomic_wide::compare_and_set_weak(shared<T>)
+        // Equivalent to atomic_wide::compare_and_set(): the double-width
+        // CAS does not fail spuriously. Provided for code written against
+        // atomic<T>.
+        template <typename G>
+        auto compare_and_set_weak(
+            versioned<T> current,
+            shared<T> next,
+            std::memory_order order,
+            G& g) -> optional_versioned<T>
+        {
+            return compare_and_set(current, next, order, g);
+        }
+
+        // atomic_wide::compare_and_set_weak(owned<T>)
+        template <typename G>
+        auto compare_and_set_weak(
+            versioned<T> current,
+            owned<T>&& next,
+            std::memory_order order,
+            G& g) -> optional_versioned<T>
+        {
+            return compare_and_set(current, std::move(next), order, g);
+        }
+
+        // atomic_wide::fetch_and()
+        // Performs a bitwise "and" operation on the current tag and the argument `value`
+        // and sets the new tag to the result. Returns the previous pointer as `shared`.
+        //
+        // The version is left unchanged, as the pointer is. Where the
+        // double-width CAS is lock-free the tag is updated with a single-width
+        // operation; otherwise with the double-width CAS.
+        template <typename G>
+        auto fetch_and(size_t value, std::memory_order order, G&) -> shared<T>
+        {
+            auto const res = (value | ~low_bits<T>());
+            if constexpr (is_always_lock_free)
+            {
+                return shared<T>::from_usize(this->data.ptr.fetch_and(res, order));
+            }
+            else
+            {
+                auto const prev = update([res](wide_value w){ return wide_value{w.ptr & res, w.version}; }, order);
+                return shared<T>::from_usize(prev.ptr);
+            }
+        }
+
+        // atomic_wide::fetch_or()
+        // Performs bitwise "or" operation on the current tag and the argument `value`
+        // and sets the new tag to the result. Returns the previous pointer as `shared`.
+        template <typename G>
+        auto fetch_or(size_t value, std::memory_order order, G&) -> shared<T>
+        {
+            auto const res = (value & low_bits<T>());
+            if constexpr (is_always_lock_free)
+            {
+                return shared<T>::from_usize(this->data.ptr.fetch_or(res, order));
+            }
+            else
+            {
+                auto const prev = update([res](wide_value w){ return wide_value{w.ptr | res, w.version}; }, order);
+                return shared<T>::from_usize(prev.ptr);
+            }
+        }
+
+        // atomic_wide::fetch_xor()
+        // Performs bitwise "xor" operaton on the current tag and the argument `value`
+        // and sets the new tag to the result. Returns the previous pointer as `shared`.
+        template <typename G>
+        auto fetch_xor(size_t value, std::memory_order order, G&) -> shared<T>
+        {
+            auto const res = (value & low_bits<T>());
+            if constexpr (is_always_lock_free)
+            {
+                return shared<T>::from_usize(this->data.ptr.fetch_xor(res, order));
+            }
+            else
+            {
+                auto const prev = update([res](wide_value w){ return wide_value{w.ptr ^ res, w.version}; }, order);
+                return shared<T>::from_usize(prev.ptr);
+            }
+        }
+
+        // atomic_wide::fetch_add_version()
+        // Increments the version by `n` without changing the pointer, e.g. to
+        // invalidate outstanding snapshots. Returns the previous version.
+        auto fetch_add_version(usize_t n, std::memory_order order) -> usize_t
+        {
+            if constexpr (is_always_lock_free)
+            {
+                return this->data.version.fetch_add(n, order);
+            }
+            else
+            {
+                return update([n](wide_value w){ return wide_value{w.ptr, w.version + n}; }, order).version;
+            }
+        }
+
+        // atomic_wide::is_null()
+        // Returns `true` if the pointer is null.
+        auto is_null() const -> bool
+        {
+            auto const [r, t] = decompose_tag<T>(ptr_relaxed());
+            return 0 == r;
+        }
+
+        // atomic_wide::is_lock_free()
+        auto is_lock_free() const noexcept -> bool
+        {
+            return is_always_lock_free;
+        }
+
+    private:
+        atomic_wide(size_t init) : data{init, 0} {}
+
+        // atomic_wide::ptr_relaxed()
+        // Reads the pointer half, for a snapshot that need not be consistent.
+        auto ptr_relaxed() const -> usize_t
+        {
+            if constexpr (is_always_lock_free)
+            {
+                return this->data.ptr.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                return wide_load(this->data, std::memory_order_relaxed).ptr;
+            }
+        }
+
+        // atomic_wide::update()
+        // Replaces the contents with `f(contents)` in a double-width CAS
+        // loop; returns the previous contents.
+        template <typename F>
+        auto update(F&& f, std::memory_order order) -> wide_value
+        {
+            auto expected = wide_value{};
+            if constexpr (is_always_lock_free)
+            {
+                // A torn initial guess only costs a retry,
+                // and saves the locked instruction of wide_load().
+                expected = wide_value{
+                    this->data.ptr.load(std::memory_order_relaxed),
+                    this->data.version.load(std::memory_order_relaxed)};
+            }
+            else
+            {
+                expected = wide_load(this->data, std::memory_order_relaxed);
+            }
+
+            while (!wide_cas(this->data, expected, f(expected), order)) {}
+            return expected;
+        }
+
+        // atomic_wide::exchange()
+        // Stores `raw` at the next version; returns the previous contents.
+        auto exchange(usize_t raw, std::memory_order order) -> wide_value
+        {
+            return update([raw](wide_value w){ return wide_value{raw, w.version + 1}; }, order);
+        }
+
+        // atomic_wide::compare_and_set_raw()
+        auto compare_and_set_raw(versioned<T>& current, usize_t next_raw, std::memory_order order)
+            -> optional_versioned<T>
+        {
+            auto expected = wide_value{current.ptr.into_usize(), current.version};
+            auto const desired = wide_value{next_raw, current.version + 1};
+            if (wide_cas(this->data, expected, desired, order))
+            {
+                return versioned<T>{shared<T>::from_usize(desired.ptr), desired.version};
+            }
+
+            // failed to perform the exchange
+            return std::nullopt;
+        }
+    };
+
+    // epic::make_atomic_wide()
+    template <typename T, typename... Args>
+    auto make_atomic_wide(Args&&... args) -> atomic_wide<T>
+    {
+        return atomic_wide<T>::make(std::forward<Args>(args)...);
+    }
+}
+
+#endif // EPIC_ATOMIC_WIDE_H
@@ -0,0 +1,93 @@
+// backoff.hpp
+
+#ifndef EPIC_BACKOFF_H
+#define EPIC_BACKOFF_H
+
+#include <thread>
+#include <algorithm>
+
+#include "type_alias.hpp"
+
+namespace epic
+{
+    // epic::backoff
+    //
+    // Exponential backoff for spin loops, after crossbeam_utils::Backoff.
+    //
+    // backoff::spin() busy-waits for an exponentially growing number of
+    // iterations; backoff::snooze() does the same at first and then yields
+    // the processor. Once backoff::is_completed() returns `true` the caller
+    // should block (or sleep) rather than keep spinning.
+    class backoff
+    {
+        constexpr static usize_t const SPIN_LIMIT  = 6;
+        constexpr static usize_t const YIELD_LIMIT = 10;
+
+        usize_t step;
+
+    public:
+        backoff() : step{0} {}
+
+        // backoff::reset()
+        auto reset() noexcept -> void
+        {
+            step = 0;
+        }
+
+        // backoff::spin()
+        // Backs off in a lock-free loop that is retrying after contention.
+        auto spin() noexcept -> void
+        {
+            for (auto i = 0ul; i < (1ul << std::min(step, SPIN_LIMIT)); ++i)
+            {
+                relax();
+            }
+
+            if (step <= SPIN_LIMIT)
+            {
+                ++step;
+            }
+        }
+
+        // backoff::snooze()
+        // Backs off in a loop that is waiting for another thread to make progress.
+        auto snooze() noexcept -> void
+        {
+            if (step <= SPIN_LIMIT)
+            {
+                for (auto i = 0ul; i < (1ul << step); ++i)
+                {
+                    relax();
+                }
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+
+            if (step <= YIELD_LIMIT)
+            {
+                ++step;
+            }
+        }
+
+        // backoff::is_completed()
+        // Returns `true` once further snoozing is unlikely to help.
+        auto is_completed() const noexcept -> bool
+        {
+            return step > YIELD_LIMIT;
+        }
+
+    private:
+        static auto relax() noexcept -> void
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+    };
+}
+
+#endif // EPIC_BACKOFF_H
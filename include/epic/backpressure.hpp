@@ -0,0 +1,43 @@
+// backpressure.hpp
+
+#ifndef EPIC_BACKPRESSURE_H
+#define EPIC_BACKPRESSURE_H
+
+namespace epic
+{
+    // epic::backpressure
+    //
+    // What guard::defer() does when the collector's garbage cap is reached,
+    // i.e. when the deferred function would seal a bag while at least
+    // `cap` sealed bags are already waiting to be collected.
+    enum class backpressure
+    {
+        // Collect and back off (spinning, then yielding, then sleeping)
+        // until the backlog drops below the cap or the global epoch has
+        // advanced past the epoch in which the caller is pinned.
+        block,
+
+        // Force one synchronous attempt to advance the epoch and collect
+        // every expired bag, then defer regardless of the outcome.
+        advance,
+
+        // Do not defer the function; guard::defer() returns
+        // defer_status::would_exceed and the caller keeps ownership.
+        reject
+    };
+
+    // epic::defer_status
+    //
+    // The result of guard::defer().
+    enum class defer_status
+    {
+        // The function was deferred (or, for a dummy guard, executed).
+        ok,
+
+        // The function was not deferred because the garbage cap
+        // was reached under backpressure::reject.
+        would_exceed
+    };
+}
+
+#endif // EPIC_BACKPRESSURE_H
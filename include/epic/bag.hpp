@@ -3,6 +3,7 @@
 #ifndef EPIC_BAG_H
 #define EPIC_BAG_H
 
+#include <array>
 #include <cstddef>
 #include <optional>
 
@@ -24,10 +25,17 @@ namespace epic
         // The current count of stored deferred functions.
         size_t count;
 
+        // The number of bytes that the stored deferred functions
+        // will release when executed, as declared by their callers.
+        size_t byte_count;
+
         // The epoch associated with this bag, once sealed.
         epoch sealed_epoch;
 
         // The inline array of deferred functions.
+        //
+        // Each `deferred` stores its callable inline,
+        // so filling a bag does not touch the heap.
         std::array<deferred, MAX_OBJECTS> deferreds;
     
     public:
@@ -38,17 +46,43 @@ namespace epic
         // bag::is_empty()
         auto is_empty() const noexcept -> bool;
 
+        // bag::size()
+        // Returns the number of stored deferred functions.
+        auto size() const noexcept -> size_t;
+
+        // bag::is_full()
+        // Returns `true` if the next push would fail.
+        auto is_full() const noexcept -> bool;
+
         // bag::is_expired()
         // Determines if it is safe to collect the given bag
         // with respect to the current global epoch.
         auto is_expired(epoch const& e) const noexcept -> bool;
 
+        // bag::size_in_bytes()
+        // Returns the number of bytes released by executing this bag.
+        auto size_in_bytes() const noexcept -> size_t;
+
         // bag::try_push()
-        auto try_push(deferred&& def) -> std::optional<deferred>;
+        // Pushes a deferred function that releases `bytes` bytes when
+        // executed; on failure (the bag is full) the function is returned.
+        auto try_push(deferred&& def, size_t bytes = 0) -> std::optional<deferred>;
+
+        // bag::push_many()
+        // Moves as many of the `n` deferred functions starting at `first`
+        // into the bag as fit, and returns the number moved. Of the `bytes`
+        // released by all `n` functions, the bag is attributed the share of
+        // those it received (see epic::bytes_share()).
+        auto push_many(deferred* first, size_t n, size_t bytes = 0) -> size_t;
 
         // bag::seal()
         // Seals the bag with the given epoch.
         auto seal(epoch const& e) -> void;
+
+        // bag::reset()
+        // Executes all stored deferred functions and returns
+        // the bag to its empty, unsealed state for reuse.
+        auto reset() -> void;
     };
 }
 
@@ -0,0 +1,63 @@
+// bag_pool.hpp
+
+#ifndef EPIC_BAG_POOL_H
+#define EPIC_BAG_POOL_H
+
+#include <memory>
+#include <vector>
+
+#include "bag.hpp"
+#include "type_alias.hpp"
+
+namespace epic
+{
+    // epic::bag_pool
+    //
+    // A bounded pool of empty bags.
+    //
+    // Bags are recycled through pools rather than returned to the
+    // allocator, so that in steady state retiring objects performs
+    // no bag allocations. A pool is owned by a single participant
+    // and is not safe for concurrent use.
+    class bag_pool
+    {
+        // The empty bags currently held by the pool.
+        std::vector<std::unique_ptr<bag>> bags;
+
+        // The maximum number of bags held by the pool.
+        usize_t const capacity;
+
+    public:
+        // The default number of bags held by a participant's pool.
+        constexpr static usize_t const DEFAULT_CAPACITY = 8;
+
+        explicit bag_pool(usize_t capacity_ = DEFAULT_CAPACITY);
+
+        bag_pool(bag_pool const&)            = delete;
+        bag_pool& operator=(bag_pool const&) = delete;
+
+        // bag_pool::take()
+        // Takes an empty bag from the pool, or returns
+        // nullptr if the pool is empty.
+        auto take() -> std::unique_ptr<bag>;
+
+        // bag_pool::try_put()
+        // Returns an empty bag to the pool.
+        //
+        // If the pool is full, the bag is handed back to the caller.
+        auto try_put(std::unique_ptr<bag>&& b) -> std::unique_ptr<bag>;
+
+        // bag_pool::size()
+        // Returns the number of bags currently held by the pool.
+        auto size() const noexcept -> usize_t;
+
+        // bag_pool::is_full()
+        auto is_full() const noexcept -> bool;
+
+        // bag_pool::clear()
+        // Frees all bags held by the pool.
+        auto clear() -> void;
+    };
+}
+
+#endif // EPIC_BAG_POOL_H
@@ -7,11 +7,18 @@
 #include <tuple>
 #include <cstddef>
 #include <cassert>
+#include <stdexcept>
 
 #include "pointer.hpp"
 
 namespace epic
 {
+    // epic::no_hold
+    //
+    // The result of hold() on a guard whose protection already lasts
+    // as long as the guard (see guard::hold()).
+    struct no_hold {};
+
     // The error returned on failed compare-and-set operation.
     // TODO
     struct compare_and_set_error
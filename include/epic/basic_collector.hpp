@@ -0,0 +1,122 @@
+// basic_collector.hpp
+
+#ifndef EPIC_BASIC_COLLECTOR_H
+#define EPIC_BASIC_COLLECTOR_H
+
+#include <memory>
+#include <cstddef>
+
+#include "basic_guard.hpp"
+
+namespace epic
+{
+    template <typename Domain, typename Local>
+    class basic_handle;
+
+    // epic::basic_collector
+    //
+    // A collector instance of a scheme that protects individual objects:
+    // epic::hp_collector and epic::ibr_collector. The scheme is supplied by
+    // the shared state `Domain` and the participant state `Local`.
+    //
+    // It has the shape of epic::collector: threads register handles, pin
+    // them to obtain guards, load from `atomic<T>`s under a guard, and retire
+    // unlinked objects with defer_destroy(). Data structure code written
+    // against that API can therefore be templated on the collector type.
+    template <typename Domain, typename Local>
+    struct basic_collector
+    {
+        using handle_type = basic_handle<Domain, Local>;
+        using guard_type  = basic_guard<Local>;
+
+        // The shared state of the scheme.
+        std::shared_ptr<Domain> instance;
+
+        basic_collector()
+            : instance{std::make_shared<Domain>()} {}
+
+        basic_collector(basic_collector const& c)            = default;
+        basic_collector& operator=(basic_collector const& c) = default;
+
+        basic_collector(basic_collector&& c)            = default;
+        basic_collector& operator=(basic_collector&& c) = default;
+
+        // basic_collector::register_handle()
+        // Registers a new participant with the collector.
+        auto register_handle() -> handle_type
+        {
+            return handle_type{instance};
+        }
+
+        // basic_collector::participants()
+        // Returns the number of participant records ever allocated;
+        // records of dropped handles are reused.
+        auto participants() const noexcept -> std::size_t
+        {
+            return instance->participants();
+        }
+    };
+
+    // epic::basic_handle
+    //
+    // A participant in a basic_collector. Like local_handle, it
+    // belongs to a single thread; unlike it, it must outlive its guards.
+    template <typename Domain, typename Local>
+    class basic_handle
+    {
+        // Declared first so that it outlives the participant.
+        std::shared_ptr<Domain> domain;
+
+        std::unique_ptr<Local> local_ptr;
+
+    public:
+        explicit basic_handle(std::shared_ptr<Domain> domain_)
+            : domain{std::move(domain_)}
+            , local_ptr{std::make_unique<Local>(*domain)} {}
+
+        // The destructor drops the participant's unprotected retired
+        // objects and hands the protected ones over to the domain.
+        ~basic_handle() = default;
+
+        basic_handle(basic_handle const&)            = delete;
+        basic_handle& operator=(basic_handle const&) = delete;
+
+        basic_handle(basic_handle&& h) = default;
+
+        basic_handle& operator=(basic_handle&& h)
+        {
+            if (&h != this)
+            {
+                // Finalize our own participant before its domain may go away.
+                local_ptr = std::move(h.local_ptr);
+                domain    = std::move(h.domain);
+            }
+
+            return *this;
+        }
+
+        // basic_handle::pin()
+        auto pin() const -> basic_guard<Local>
+        {
+            return basic_guard<Local>{local_ptr.get()};
+        }
+
+        // basic_handle::pending()
+        // Returns the number of objects retired by this participant
+        // that have not been dropped yet.
+        auto pending() const noexcept -> std::size_t
+        {
+            return local_ptr->pending();
+        }
+
+        // basic_handle::overwritten()
+        // Returns the number of protections this participant dropped
+        // by reusing them; see hp_guard::hold().
+        auto overwritten() const noexcept -> std::size_t
+        {
+            return local_ptr->overwritten();
+        }
+    };
+}
+
+#endif // EPIC_BASIC_COLLECTOR_H
@@ -0,0 +1,179 @@
+// basic_guard.hpp
+
+#ifndef EPIC_BASIC_GUARD_H
+#define EPIC_BASIC_GUARD_H
+
+#include <atomic>
+#include <type_traits>
+
+#include "base.hpp"
+#include "shared.hpp"
+#include "pointer.hpp"
+#include "type_alias.hpp"
+#include "backpressure.hpp"
+
+namespace epic
+{
+    // epic::basic_guard
+    //
+    // The guard of a collector that protects individual objects rather
+    // than pinning an epoch: epic::hp_guard (hazard pointers) and
+    // epic::ibr_guard (interval-based reclamation).
+    //
+    // It stands in for epic::guard in code written against atomic<T>.
+    // The scheme is supplied by the participant type `Local`, which
+    // provides:
+    //
+    //  - enter() / leave(), called by the first / last guard,
+    //  - protect(src, order, tag_mask), used by atomic<T>::load(),
+    //  - retire<T>(raw), used by defer_destroy(),
+    //  - scan(), used by flush(),
+    //  - hold(raw), if `Local::hold_type` is not epic::no_hold.
+    template <typename Local>
+    class basic_guard
+    {
+        Local* local_ptr;
+
+    public:
+        // The result of basic_guard::hold().
+        using hold_type = typename Local::hold_type;
+
+        // The default constructor has the same effect as basic_guard::unprotected().
+        basic_guard()
+            : local_ptr{nullptr} {}
+
+        explicit basic_guard(Local* local_ptr_)
+            : local_ptr{local_ptr_}
+        {
+            if (!is_dummy())
+            {
+                local_ptr->enter();
+            }
+        }
+
+        ~basic_guard()
+        {
+            if (!is_dummy())
+            {
+                local_ptr->leave();
+            }
+        }
+
+        // A guard is non-copyable; moving a guard transfers
+        // its protection and leaves behind a dummy guard.
+        basic_guard(basic_guard const&)            = delete;
+        basic_guard& operator=(basic_guard const&) = delete;
+
+        basic_guard(basic_guard&& g)
+            : local_ptr{g.local_ptr}
+        {
+            g.local_ptr = nullptr;
+        }
+
+        basic_guard& operator=(basic_guard&& g)
+        {
+            if (&g != this)
+            {
+                if (!is_dummy())
+                {
+                    local_ptr->leave();
+                }
+
+                local_ptr   = g.local_ptr;
+                g.local_ptr = nullptr;
+            }
+
+            return *this;
+        }
+
+        // basic_guard::protect()
+        // Loads the tagged pointer stored in `src` and protects its pointee;
+        // `tag_mask` selects the tag bits. Used by atomic<T>::load().
+        auto protect(atomic_usize_t const& src, std::memory_order order,
+            usize_t const tag_mask) -> usize_t
+        {
+            if (is_dummy())
+            {
+                return src.load(order);
+            }
+
+            return local_ptr->protect(src, order, tag_mask);
+        }
+
+        // basic_guard::hold()
+        // Keeps the pointee of `ptr`, loaded under this guard, protected
+        // until the result is dropped; see hp_guard. A no-op for schemes
+        // whose protection already lasts as long as the guard.
+        template <typename T>
+        auto hold(shared<T> ptr) -> hold_type
+        {
+            if constexpr (std::is_same_v<hold_type, no_hold>)
+            {
+                return no_hold{};
+            }
+            else
+            {
+                if (is_dummy())
+                {
+                    return hold_type{};
+                }
+
+                auto const [raw, tag] = decompose_tag<T>(ptr.into_usize());
+                return hold_type{local_ptr, local_ptr->hold(raw)};
+            }
+        }
+
+        // basic_guard::defer_destroy()
+        // Retires the object `ptr` points to; it is dropped once the scheme
+        // no longer protects it. It must already be unlinked from any shared
+        // structure.
+        //
+        // Signature compatible with guard::defer_destroy(): these schemes
+        // keep the backlog bounded, so `bytes` is not tracked and the result
+        // is always defer_status::ok. On a dummy guard the object is dropped
+        // immediately.
+        template <typename T>
+        auto defer_destroy(shared<T>&& ptr, usize_t = 0) -> defer_status
+        {
+            auto const [raw, tag] = decompose_tag<T>(ptr.into_usize());
+            if (is_dummy())
+            {
+                pointable<T>::drop(raw);
+            }
+            else
+            {
+                local_ptr->template retire<T>(raw);
+            }
+
+            return defer_status::ok;
+        }
+
+        // basic_guard::flush()
+        // Scans the protections of all participants and drops every retired
+        // object of this participant that is no longer protected.
+        auto flush() -> void
+        {
+            if (!is_dummy())
+            {
+                local_ptr->scan();
+            }
+        }
+
+        // basic_guard::is_dummy()
+        // Determines if this is a dummy guard created by basic_guard::unprotected().
+        auto is_dummy() const noexcept -> bool
+        {
+            return nullptr == local_ptr;
+        }
+
+        // basic_guard::unprotected()
+        // Returns a dummy guard, which protects nothing and drops retired
+        // objects immediately; for constructing or destroying a data structure.
+        static auto unprotected() -> basic_guard
+        {
+            return basic_guard{};
+        }
+    };
+}
+
+#endif // EPIC_BASIC_GUARD_H
@@ -0,0 +1,55 @@
+// cache_padded.hpp
+
+#ifndef EPIC_CACHE_PADDED_H
+#define EPIC_CACHE_PADDED_H
+
+#include <utility>
+
+#include "type_alias.hpp"
+
+namespace epic
+{
+    // The assumed size of a cache line, in bytes.
+    //
+    // Modern Intel processors prefetch cache lines in adjacent pairs,
+    // so (like crossbeam) we pad to 128 bytes rather than 64.
+    constexpr static usize_t const CACHE_LINE_SIZE = 128;
+
+    // epic::cache_padded
+    //
+    // Pads and aligns a value to the length of a cache line.
+    //
+    // Use this to prevent false sharing between values that are
+    // written by different threads.
+    template <typename T>
+    struct alignas(CACHE_LINE_SIZE) cache_padded
+    {
+        T value;
+
+        template <typename... Args>
+        cache_padded(Args&&... args) 
+            : value{std::forward<Args>(args)...} {}
+
+        auto operator*() noexcept -> T&
+        {
+            return value;
+        }
+
+        auto operator*() const noexcept -> T const&
+        {
+            return value;
+        }
+
+        auto operator->() noexcept -> T*
+        {
+            return &value;
+        }
+
+        auto operator->() const noexcept -> T const*
+        {
+            return &value;
+        }
+    };
+}
+
+#endif // EPIC_CACHE_PADDED_H
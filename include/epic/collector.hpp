@@ -4,22 +4,55 @@
 #define EPIC_COLLECTOR_H
 
 #include <memory>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+#include "hyaline.hpp"
+#include "reclaimer.hpp"
+#include "membarrier.hpp"
+#include "stats.hpp"
+#include "watchdog.hpp"
+#include "backpressure.hpp"
 
 namespace epic
 {
     struct global;
+    class guard;
     class local_handle;
 
     // epic::collector
     //
     // An epoch-based garbage collector instance.
+    //
+    // The same handles, guards, and deferred functions also run on
+    // reference-counted batches instead of epochs; see scheme::hyaline.
     struct collector
     {
+        using handle_type = local_handle;
+        using guard_type  = guard;
+
         // The shared global data.
         std::shared_ptr<global> instance;
 
         collector();
 
+        // Construct a collector that uses the given fence mode.
+        //
+        // Requesting fence_mode::asymmetric falls back to symmetric
+        // fences if membarrier() is unavailable; see get_fence_mode().
+        explicit collector(fence_mode mode);
+
+        // Construct a collector that uses the given reclamation scheme.
+        //
+        // Under scheme::hyaline, participants are never scanned: a sealed bag
+        // is executed by the last participant to unpin among those pinned
+        // when it was sealed, so deferred functions may run from the
+        // destructor of a guard. The background reclaimer, the watchdog,
+        // and neutralization have nothing to do under it, and pins always
+        // use symmetric fences.
+        explicit collector(scheme s, fence_mode mode = fence_mode::symmetric);
+
         collector(collector const& c);
 
         collector& operator=(collector const& c);
@@ -38,6 +71,189 @@ namespace epic
         // API, this is the entry point for individual threads.
         auto register_handle() -> local_handle;
 
+        // collector::register_reader()
+        // Register a new reader-only handle with the collector.
+        //
+        // A reader-only handle never executes collection inline,
+        // neither periodically from pin() nor from guard::flush().
+        // It is intended for latency-sensitive threads and should
+        // be paired with the background reclaimer (or with other,
+        // regular handles) so that garbage is still collected.
+        auto register_reader() -> local_handle;
+
+        // collector::register_qsbr()
+        // Register a new quiescent-state-based (QSBR) handle with the collector.
+        //
+        // A QSBR participant is pinned for as long as it is online, so pinning
+        // a guard only increments a counter. In exchange it must report a
+        // quiescent state with local_handle::quiescent() regularly, e.g. at the
+        // top of its event loop, while it holds no shared pointers and no
+        // guards; until it does, the global epoch cannot advance past it.
+        // A participant that blocks should go offline() first. QSBR and
+        // ordinary handles may be registered with the same collector.
+        auto register_qsbr() -> local_handle;
+
+        // collector::start_reclaimer()
+        // Start a dedicated background thread that advances the
+        // global epoch and drains the global queue of deferred
+        // functions every `interval`.
+        //
+        // Returns `false` if the reclaimer is already running.
+        auto start_reclaimer(
+            std::chrono::milliseconds interval = reclaimer::DEFAULT_INTERVAL) -> bool;
+
+        // collector::stop_reclaimer()
+        // Stop the background reclaimer and wait for it to exit.
+        //
+        // Returns `false` if the reclaimer was not running. The
+        // reclaimer is also stopped when the global state is dropped.
+        auto stop_reclaimer() -> bool;
+
+        // collector::is_reclaimer_running()
+        auto is_reclaimer_running() const -> bool;
+
+        // collector::start_workers()
+        // Start a pool of `threads` worker threads that execute expired
+        // bags in parallel with the threads that collect them.
+        //
+        // While the pool runs, collection (inline, from guard::flush(), or
+        // by the background reclaimer) only pops expired bags and hands
+        // them over. The pool also drains all remaining garbage in
+        // parallel when the collector is destroyed.
+        // Returns `false` if the pool is already running.
+        auto start_workers(std::size_t threads) -> bool;
+
+        // collector::stop_workers()
+        // Stop the worker pool once it has executed the bags handed to it.
+        // Returns `false` if the pool was not running.
+        auto stop_workers() -> bool;
+
+        // collector::worker_count()
+        // Returns the number of worker threads in the pool.
+        auto worker_count() const -> std::size_t;
+
+        // collector::set_stall_watchdog()
+        // Invoke `callback` when a participant has kept the global epoch
+        // from advancing for longer than `threshold`.
+        //
+        // Stalls are detected by the scan that attempts to advance the
+        // epoch, so pinning costs nothing extra; a stall is only noticed
+        // while some thread (a collecting participant or the background
+        // reclaimer) keeps trying to advance, i.e. while garbage is pending.
+        // The callback fires once per stalled epoch; see epic::stall_callback.
+        auto set_stall_watchdog(std::chrono::nanoseconds threshold, stall_callback callback) -> void;
+
+        // collector::clear_stall_watchdog()
+        auto clear_stall_watchdog() -> void;
+
+        // collector::enable_neutralization()
+        // Enables the robust mode: once the global epoch has been stuck for
+        // `patience`, threads that hold it back from inside a restartable
+        // read phase (see epic::restartable()) are sent `signal` (SIGRTMIN
+        // if zero) and restart that read phase, so garbage stays bounded
+        // whatever readers do. Returns `false` if the signal handler could
+        // not be installed. The handler is installed process-wide.
+        auto enable_neutralization(std::chrono::nanoseconds patience, int signal = 0) -> bool;
+
+        // collector::disable_neutralization()
+        auto disable_neutralization() -> void;
+
+        // collector::synchronize()
+        // Blocks until every reader that is pinned when this is called has
+        // unpinned, i.e. until a grace period has elapsed: objects unlinked
+        // before the call are then unreachable, and may be unmapped or
+        // closed directly instead of through guard::defer().
+        //
+        // The epoch is advanced periodically while waiting. Concurrent
+        // callers share grace periods, and the calling thread must not be
+        // pinned in this collector (it would wait for itself).
+        auto synchronize() -> void;
+
+        // collector::synchronize_expedited()
+        // Like synchronize(), but advances the epoch as fast as stragglers
+        // allow, backing off while one stays pinned. Concurrent callers of
+        // synchronize() then benefit from the expedited grace periods too.
+        auto synchronize_expedited() -> void;
+
+        // collector::notify_after_grace_period()
+        // Invokes `callback` once every reader that is pinned when this is
+        // called has unpinned, without blocking the caller.
+        //
+        // The callback runs on whichever thread collects garbage after the
+        // grace period (a participant, the background reclaimer, or a worker),
+        // so it should be quick and must not block. Completion requires the
+        // epoch to advance: if every participant may be idle, run the
+        // background reclaimer.
+        auto notify_after_grace_period(std::function<void()> callback) -> void;
+
+        // collector::grace_period_fd()
+        // Returns the collector's eventfd, which becomes readable when
+        // grace periods requested with request_grace_period() complete;
+        // reading it returns (and resets) the number of completions.
+        //
+        // The descriptor is non-blocking, owned by the collector, and
+        // created on first use; returns -1 if it cannot be created.
+        auto grace_period_fd() -> int;
+
+        // collector::request_grace_period()
+        // Requests a grace period whose completion signals grace_period_fd(),
+        // for event loops that retire resources asynchronously. Returns
+        // `false` if the eventfd cannot be created.
+        auto request_grace_period() -> bool;
+
+        // collector::stats()
+        // Returns a snapshot of the collector's statistics, which can be
+        // rendered with collector_stats::to_json() or to_prometheus().
+        //
+        // The counters are maintained only if the library is built with
+        // EPIC_STATS; the gauges (pending bags, epoch, ...) always are.
+        auto stats() const -> collector_stats;
+
+        // collector::trim()
+        // Frees the empty bags that the collector keeps for recycling.
+        //
+        // Bags held by the shared pool are freed immediately; each
+        // participant frees the bags in its own pool the next time it
+        // needs a bag or collects. Call this under memory pressure.
+        // Returns the number of bags freed immediately.
+        auto trim() -> std::size_t;
+
+        // collector::set_byte_threshold()
+        // Sets the number of unreclaimed bytes (as declared to guard::defer())
+        // above which participants force the epoch forward and collect on
+        // every pin. Zero disables pressure-triggered collection.
+        auto set_byte_threshold(std::size_t bytes) -> void;
+
+        // collector::get_byte_threshold()
+        auto get_byte_threshold() const -> std::size_t;
+
+        // collector::unreclaimed_bytes()
+        // Returns the approximate number of bytes deferred but not yet reclaimed.
+        auto unreclaimed_bytes() const -> std::size_t;
+
+        // collector::set_garbage_cap()
+        // Bounds the number of sealed bags awaiting collection.
+        //
+        // Once `bags` sealed bags are pending, a participant that is about to
+        // seal another one in guard::defer() applies `policy` first. Zero
+        // (the default) leaves the backlog unbounded. The cap is approximate:
+        // participants that reach it concurrently may each seal one bag.
+        auto set_garbage_cap(std::size_t bags, backpressure policy = backpressure::block) -> void;
+
+        // collector::get_garbage_cap()
+        auto get_garbage_cap() const -> std::size_t;
+
+        // collector::get_backpressure()
+        auto get_backpressure() const -> backpressure;
+
+        // collector::get_fence_mode()
+        // Returns the fence mode in effect for this collector.
+        auto get_fence_mode() const -> fence_mode;
+
+        // collector::get_scheme()
+        // Returns the reclamation scheme of this collector.
+        auto get_scheme() const -> scheme;
+
         // collector::release()
         // Release reference to the global shared state.
         auto release() -> void;
@@ -0,0 +1,42 @@
+// default.hpp
+
+#ifndef EPIC_DEFAULT_H
+#define EPIC_DEFAULT_H
+
+#include "guard.hpp"
+#include "collector.hpp"
+#include "local_handle.hpp"
+
+namespace epic
+{
+    // The default garbage collector.
+    //
+    // For each thread, a participant is lazily initialized on its
+    // first use, when the current thread is registered in the default
+    // collector. If initialized, the thread's participant will get
+    // destructed on thread exit, which in turn unregisters the thread.
+
+    // epic::default_collector()
+    // Returns the process-wide default collector, creating it on first use.
+    auto default_collector() -> collector&;
+
+    // epic::default_handle()
+    // Returns the current thread's handle to the default collector,
+    // registering the current thread on first use.
+    //
+    // The returned reference is valid until the current thread exits.
+    auto default_handle() -> local_handle const&;
+
+    // epic::pin()
+    // Pins the current thread in the default collector.
+    //
+    // After the current thread is registered, this is a single
+    // thread-local load followed by local::pin().
+    auto pin() -> guard;
+
+    // epic::is_pinned()
+    // Returns `true` if the current thread is pinned in the default collector.
+    auto is_pinned() -> bool;
+}
+
+#endif // EPIC_DEFAULT_H
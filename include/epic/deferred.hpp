@@ -3,51 +3,281 @@
 #ifndef EPIC_DEFERRED_H
 #define EPIC_DEFERRED_H
 
-#include <functional>
+#include <new>
+#include <memory>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+#include "pointer.hpp"
+#include "type_alias.hpp"
 
 namespace epic
 {
     // A deferred function wrapper.
     //
-    // TODO: implement inline optimization from crossbeam::epoch.
+    // This is the inline optimization from crossbeam::epoch. Rather
+    // than wrapping a std::function<void()>, which heap-allocates for
+    // all but the smallest captures, a `deferred` stores its callable
+    // inline in a buffer of DATA_WORDS machine words, next to a pointer
+    // to a type-erased trampoline that invokes it. Callables that do not
+    // fit in the buffer are boxed on the heap; this is the uncommon path.
+    //
+    // A deferred function is invoked at most once: deferred::call()
+    // consumes the stored callable and leaves a no-op in its place.
     class deferred
     {
-        std::function<void()> fn;
-    
     public:
-        deferred(std::function<void()>&& f) 
-            : fn{std::move(f)} {}
-        
-        ~deferred() = default;
+        // The number of machine words available for inline storage.
+        constexpr static usize_t const DATA_WORDS = 3;
+
+    private:
+        using data_t = std::aligned_storage_t<
+            DATA_WORDS*sizeof(usize_t), alignof(usize_t)>;
+
+        // The operations supported by the type-erased manager.
+        enum class op { move, destroy };
+
+        // Invokes, and then destroys, the callable stored in `data`.
+        using call_fn = void (*)(void*);
+
+        // Relocates (op::move) or destroys (op::destroy) the callable
+        // stored at `src`. Null when the stored callable is trivially
+        // copyable, in which case relocation is a plain memcpy.
+        using manage_fn = void (*)(op, void* dst, void* src);
+
+        call_fn   invoke;
+        manage_fn manage;
+        data_t    data;
+
+    public:
+        // The default constructor produces a no-op deferred function.
+        deferred() noexcept
+            : invoke{&deferred::call_no_op}
+            , manage{nullptr}
+            , data{}
+        {}
+
+        template <typename F, typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<F>, deferred>>>
+        deferred(F&& f) : deferred{}
+        {
+            emplace(std::forward<F>(f));
+        }
+
+        ~deferred()
+        {
+            reset();
+        }
 
         deferred(deferred const&)            = delete;
         deferred& operator=(deferred const&) = delete;
 
-        deferred(deferred&& d) : fn{std::move(d.fn)} {}
-        deferred& operator=(deferred&& d)
+        deferred(deferred&& d) noexcept : deferred{}
+        {
+            take(d);
+        }
+
+        deferred& operator=(deferred&& d) noexcept
         {
             if (&d != this)
             {
-                this->fn = std::move(d.fn);
+                reset();
+                take(d);
             }
 
             return *this;
         }
 
+        // deferred::make()
+        // Constructs a new deferred function from the callable `f`.
+        template <typename F>
+        static auto make(F&& f) -> deferred
+        {
+            return deferred{std::forward<F>(f)};
+        }
+
+        // deferred::make_destroy()
+        // Constructs a deferred function that drops the pointee
+        // at address `raw` via pointable<T>::drop().
+        //
+        // This is the fast path for guard::defer_destroy(): the
+        // deferred consists of only a function pointer and a word
+        // of data, and never requires a type-erased manager.
+        template <typename T>
+        static auto make_destroy(usize_t raw) noexcept -> deferred
+        {
+            auto d = deferred{};
+            d.invoke = &deferred::call_destroy<T>;
+            ::new (&d.data) usize_t{raw};
+            return d;
+        }
+
+        // deferred::fits_inline()
+        // Returns `true` if callable type `F` is stored inline.
+        template <typename F>
+        constexpr static auto fits_inline() noexcept -> bool
+        {
+            return sizeof(F) <= sizeof(data_t)
+                && alignof(F) <= alignof(data_t)
+                && std::is_nothrow_move_constructible_v<F>;
+        }
+
         // deferred::call()
         // Invoke the deferred function.
+        //
+        // The stored callable is consumed; subsequent calls are no-ops.
         auto call() -> void
         {
-            fn();
+            auto* const fn = invoke;
+            invoke = &deferred::call_no_op;
+            manage = nullptr;
+            fn(&data);
         }
 
         // deferred::swap()
         // Swap the wrapped function with the contents of another wrapper.
-        auto swap(deferred& rhs) -> void
+        auto swap(deferred& rhs) noexcept -> void
         {
-            std::swap(fn, rhs.fn);
+            auto tmp = std::move(rhs);
+            rhs   = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+    private:
+        template <typename F>
+        auto emplace(F&& f) -> void
+        {
+            using fn_t = std::decay_t<F>;
+
+            if constexpr (fits_inline<fn_t>())
+            {
+                ::new (&data) fn_t{std::forward<F>(f)};
+                invoke = &deferred::call_inline<fn_t>;
+                if constexpr (!std::is_trivially_copyable_v<fn_t>)
+                {
+                    manage = &deferred::manage_inline<fn_t>;
+                }
+            }
+            else
+            {
+                // Slow path: box the callable and store the pointer inline.
+                ::new (&data) fn_t*{new fn_t{std::forward<F>(f)}};
+                invoke = &deferred::call_boxed<fn_t>;
+                manage = &deferred::manage_boxed<fn_t>;
+            }
+        }
+
+        // deferred::take()
+        // Relocate the callable stored in `d` into this (empty) wrapper.
+        auto take(deferred& d) noexcept -> void
+        {
+            if (nullptr == d.manage)
+            {
+                std::memcpy(&data, &d.data, sizeof(data_t));
+            }
+            else
+            {
+                d.manage(op::move, &data, &d.data);
+            }
+
+            invoke = d.invoke;
+            manage = d.manage;
+
+            d.invoke = &deferred::call_no_op;
+            d.manage = nullptr;
+        }
+
+        // deferred::reset()
+        // Destroy the stored callable without invoking it.
+        auto reset() noexcept -> void
+        {
+            if (nullptr != manage)
+            {
+                manage(op::destroy, nullptr, &data);
+            }
+
+            invoke = &deferred::call_no_op;
+            manage = nullptr;
+        }
+
+        static auto call_no_op(void*) -> void {}
+
+        template <typename T>
+        static auto call_destroy(void* p) -> void
+        {
+            pointable<T>::drop(*static_cast<usize_t*>(p));
+        }
+
+        template <typename F>
+        static auto call_inline(void* p) -> void
+        {
+            auto* f = std::launder(static_cast<F*>(p));
+            if constexpr (std::is_trivially_destructible_v<F>)
+            {
+                (*f)();
+            }
+            else
+            {
+                // Destroy the callable even if invoking it throws.
+                struct destroy_on_exit
+                {
+                    F* f;
+                    ~destroy_on_exit() { f->~F(); }
+                } d{f};
+
+                (*f)();
+            }
+        }
+
+        template <typename F>
+        static auto manage_inline(op o, void* dst, void* src) -> void
+        {
+            auto* f = std::launder(static_cast<F*>(src));
+            if (op::move == o)
+            {
+                ::new (dst) F{std::move(*f)};
+            }
+
+            f->~F();
+        }
+
+        template <typename F>
+        static auto call_boxed(void* p) -> void
+        {
+            auto boxed = std::unique_ptr<F>{*static_cast<F**>(p)};
+            (*boxed)();
+        }
+
+        template <typename F>
+        static auto manage_boxed(op o, void* dst, void* src) -> void
+        {
+            if (op::move == o)
+            {
+                std::memcpy(dst, src, sizeof(F*));
+            }
+            else
+            {
+                delete *static_cast<F**>(src);
+            }
         }
     };
+
+    // epic::bytes_share()
+    // Returns the share of `bytes`, released by `n` deferred functions
+    // together, that is attributed to `k` of them. Splitting a batch with
+    // it keeps every bag's byte count proportional to its functions, and
+    // the shares of all parts sum to `bytes`.
+    inline auto bytes_share(usize_t const bytes, usize_t const k, usize_t const n) noexcept -> usize_t
+    {
+        if (k >= n)
+        {
+            return bytes;
+        }
+
+        // (bytes*k)/n without overflowing for large `bytes`.
+        return (bytes / n)*k + ((bytes % n)*k) / n;
+    }
 }
 
-#endif // EPIC_DEFERRED_H
\ No newline at end of file
+#endif // EPIC_DEFERRED_H
@@ -105,12 +105,12 @@ namespace epic
             return this->data;
         }
 
-        auto operator==(epoch const& e) -> bool
+        auto operator==(epoch const& e) const -> bool
         {
             return data == e.data;
         }
 
-        auto operator!=(epoch const& e) -> bool
+        auto operator!=(epoch const& e) const -> bool
         {
             return data != e.data;
         }
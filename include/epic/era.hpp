@@ -0,0 +1,69 @@
+// era.hpp
+
+#ifndef EPIC_ERA_H
+#define EPIC_ERA_H
+
+#include <atomic>
+#include <type_traits>
+
+#include "type_alias.hpp"
+#include "cache_padded.hpp"
+
+namespace epic
+{
+    // epic::era_clock()
+    // Returns the global era clock of interval-based reclamation.
+    //
+    // A single clock is shared by every ibr_collector, since objects are
+    // stamped with their birth era when allocated, before they are known
+    // to belong to any collector. The clock starts at 1, so that era 0
+    // precedes every reservation.
+    inline auto era_clock() noexcept -> atomic_usize_t&
+    {
+        static auto clock = cache_padded<atomic_usize_t>{1ul};
+        return *clock;
+    }
+
+    // epic::era_stamped
+    //
+    // The object header of interval-based reclamation (see ibr_collector).
+    //
+    // pointable<T>::init() stamps an object of a type derived from
+    // `era_stamped` with the era in which it is allocated. An object
+    // whose type is not derived from it is treated as born in era 0:
+    // it is still reclaimed safely, but a stalled reader holds it back
+    // as under epoch-based reclamation.
+    struct era_stamped
+    {
+        usize_t birth_era = 0;
+    };
+
+    // epic::stamp_birth_era()
+    // Stamps the object at `p` with the current era, if its type is era-stamped.
+    template <typename T>
+    auto stamp_birth_era(T* p) noexcept -> void
+    {
+        if constexpr (std::is_base_of_v<era_stamped, T>)
+        {
+            static_cast<era_stamped*>(p)->birth_era 
+                = era_clock().load(std::memory_order_acquire);
+        }
+    }
+
+    // epic::birth_era()
+    // Returns the birth era of the object at `p`; 0 if its type is not era-stamped.
+    template <typename T>
+    auto birth_era(T const* p) noexcept -> usize_t
+    {
+        if constexpr (std::is_base_of_v<era_stamped, T>)
+        {
+            return static_cast<era_stamped const*>(p)->birth_era;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+}
+
+#endif // EPIC_ERA_H
@@ -0,0 +1,95 @@
+// executor.hpp
+
+#ifndef EPIC_EXECUTOR_H
+#define EPIC_EXECUTOR_H
+
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "type_alias.hpp"
+
+namespace epic
+{
+    class bag;
+    struct global;
+
+    // epic::executor
+    //
+    // A small pool of worker threads that execute expired bags
+    // on behalf of a collector instance.
+    //
+    // While the pool is running, global::collect() hands every expired
+    // bag it pops to the pool instead of executing it inline, so that a
+    // large backlog (e.g. after a long read-side stall) is destroyed in
+    // parallel rather than by the one thread that happened to collect.
+    // When the collector is torn down its remaining bags are drained
+    // through the pool as well.
+    class executor
+    {
+        // The worker threads, if running.
+        std::vector<std::thread> workers;
+
+        // Guards `work` and the waits on `ready`.
+        std::mutex lock;
+
+        // Signalled when work is submitted or the pool is stopped.
+        std::condition_variable ready;
+
+        // The expired bags waiting to be executed.
+        std::deque<std::unique_ptr<bag>> work;
+
+        // Is the pool accepting work?
+        // Written under `lock`, read without it by global::collect().
+        std::atomic_bool running;
+
+        // Serializes start / stop.
+        std::mutex control;
+
+    public:
+        executor();
+
+        // The destructor stops the pool, if it is running.
+        ~executor();
+
+        executor(executor const&)            = delete;
+        executor& operator=(executor const&) = delete;
+
+        executor(executor&&)            = delete;
+        executor& operator=(executor&&) = delete;
+
+        // executor::start()
+        // Start `threads` worker threads that execute bags collected
+        // from `g`. Returns `false` if already running or `threads` is 0.
+        auto start(global& g, usize_t threads) -> bool;
+
+        // executor::stop()
+        // Stop accepting work, wait for the workers to execute every
+        // bag submitted so far, and join them.
+        // Returns `false` if the pool was not running.
+        auto stop() -> bool;
+
+        // executor::submit()
+        // Hands the expired bag `b` to the pool. If the pool is not running
+        // the bag is returned, and the caller should execute it inline.
+        auto submit(std::unique_ptr<bag>&& b) -> std::unique_ptr<bag>;
+
+        // executor::is_running()
+        auto is_running() const -> bool;
+
+        // executor::thread_count()
+        // Returns the number of worker threads (zero if not running).
+        auto thread_count() -> usize_t;
+
+    private:
+        // executor::run()
+        // A worker thread's main loop.
+        auto run(global& g) -> void;
+    };
+}
+
+#endif // EPIC_EXECUTOR_H
@@ -5,49 +5,312 @@
 
 #include "bag.hpp"
 #include "epoch.hpp"
+#include "bag_pool.hpp"
+#include "registry.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "grace.hpp"
+#include "executor.hpp"
+#include "hyaline.hpp"
+#include "watchdog.hpp"
+#include "neutralize.hpp"
+#include "reclaimer.hpp"
+#include "membarrier.hpp"
+#include "backpressure.hpp"
+#include "cache_padded.hpp"
 
-#include <lowlock/list.hpp>
+#include <memory>
 #include <lowlock/queue.hpp>
 
 namespace epic
 {
     class local;
 
+    // epic::garbage_shard
+    //
+    // One shard of the global store of sealed bags.
+    struct garbage_shard
+    {
+        // The queue of sealed bags pushed to this shard.
+        lowlock::queue<bag> bags;
+
+        // The number of sealed bags in this shard (approximate).
+        atomic_usize_t pending;
+
+        // The number of bags pushed to and collected from this shard.
+        counter pushed;
+        counter collected;
+
+        garbage_shard();
+    };
+
     // epic::global
     //
     // The global data for a collector instance.
     struct global
     {
-        // Number of bags to destroy.
-        static usize_t const COLLECT_STEPS = 8;
+        // Number of bags to destroy when the backlog is small.
+        constexpr static usize_t const COLLECT_STEPS = 8;
+
+        // Upper bound on the number of bags to destroy per collection.
+        constexpr static usize_t const MAX_COLLECT_STEPS = 64;
+
+        // Upper bound on the number of garbage shards.
+        constexpr static usize_t const MAX_SHARDS = 64;
+
+        // Upper bound on the number of bags in the shared free pool.
+        constexpr static usize_t const MAX_FREE_BAGS = 256;
+
+        // The default number of unreclaimed bytes above which
+        // participants force the epoch forward and collect eagerly.
+        constexpr static usize_t const DEFAULT_BYTE_THRESHOLD = 64ul << 20;
+
+        // The fields of the global data are grouped by access pattern,
+        // and each group that is written at runtime starts on its own
+        // cache line (checked by static_asserts in global.cpp).
+
+        // -- Read-mostly: read on every pin or collection,
+        //    written only on registration or trim.
+
+        // The registry of participant slots, scanned by try_advance().
+        registry participants;
+
+        // The number of garbage shards; always a power of two.
+        usize_t const shard_count;
+
+        // Do participants publish their epochs with asymmetric fences?
+        //
+        // Only `true` if asymmetric fences were requested and the process
+        // was successfully registered for expedited membarrier().
+        bool const asymmetric_fences;
 
-        // The intrusive linked list of `local`s.
-        lowlock::list locals;
+        // The reference-counted batches of scheme::hyaline;
+        // null under scheme::epoch.
+        std::unique_ptr<hyaline_domain> const hyaline;
 
-        // The global queue of deferred functions.
-        lowlock::queue<bag> deferred_functions;
+        // The global store of deferred functions, split into shards.
+        //
+        // Each participant pushes its sealed bags to its own shard so
+        // that the queue head and tail are not contended by all threads.
+        std::unique_ptr<cache_padded<garbage_shard>[]> shards;
+
+        // Incremented by global::trim(). Participants that observe a new
+        // generation free the bags held in their own pools.
+        atomic_usize_t trim_generation;
+
+        // The number of unreclaimed bytes at which the collector is under
+        // memory pressure; zero disables pressure-triggered collection.
+        atomic_usize_t byte_threshold;
+
+        // The maximum number of sealed bags awaiting collection before
+        // guard::defer() applies `policy`; zero means unbounded.
+        atomic_usize_t garbage_cap;
+
+        // What guard::defer() does when the garbage cap is reached.
+        std::atomic<backpressure> policy;
+
+        // -- The global epoch: read on every pin, written on every advance.
 
         // The global epoch.
-        atomic_epoch global_epoch;
+        alignas(CACHE_LINE_SIZE) atomic_epoch global_epoch;
+
+        // -- Stall handling: written on every advance and when stalled.
+
+        // The stalled-participant watchdog. Its advance timestamp is
+        // written on every advance, so it must not share the line of
+        // the global epoch, which every pin reads.
+        alignas(CACHE_LINE_SIZE) watchdog stall_watch;
+
+        // The robust mode, which neutralizes stalled read phases.
+        neutralizer robust;
+
+        // -- Shard bookkeeping: written when shards fill up or drain.
+
+        // The number of shards with pending bags (approximate).
+        //
+        // This is updated only when a shard becomes empty or non-empty,
+        // and lets collection bail out early when there is no garbage.
+        alignas(CACHE_LINE_SIZE) atomic_usize_t nonempty_shards;
+
+        // Counter used to assign participants to shards round-robin.
+        atomic_usize_t next_shard;
+
+        // The number of bytes deferred for release but not yet reclaimed,
+        // as declared by the callers of guard::defer() (approximate).
+        // Updated once per sealed bag, not on every deferred function.
+        atomic_usize_t unreclaimed_bytes;
+
+        // -- The shared free pool: written whenever bags are recycled.
+
+        // The shared pool of empty bags.
+        //
+        // Absorbs recycled bags when the collecting thread's own pool is
+        // full (or when it has none, like the background reclaimer), and
+        // supplies bags to participants whose own pool is empty.
+        alignas(CACHE_LINE_SIZE) lowlock::queue<bag> free_bags;
 
+        // The number of bags in the shared free pool (approximate).
+        atomic_usize_t free_count;
+
+        // -- Statistics: empty unless compiled in.
+
+        // The counters shared by all participants.
+        alignas(CACHE_LINE_SIZE) collector_counters counters;
+
+        // -- Cold: touched only by the background threads.
+
+        // The optional background reclamation thread.
+        alignas(CACHE_LINE_SIZE) reclaimer background;
+
+        // The optional pool of threads that execute expired bags.
+        executor workers;
+
+        // The callers of synchronize() waiting for a grace period.
+        grace_periods grace;
+
+        // The default constructor creates one shard per hardware thread,
+        // rounded up to a power of two and capped at MAX_SHARDS, and
+        // uses symmetric fences.
         global();
 
+        // Construct the global data with the default number of
+        // shards and the requested fence mode and scheme.
+        explicit global(fence_mode mode, scheme s = scheme::epoch);
+
+        // Construct the global data with `shard_count_` garbage shards
+        // (rounded up to a power of two and capped at MAX_SHARDS).
+        explicit global(usize_t shard_count_, 
+            fence_mode mode = fence_mode::symmetric, scheme s = scheme::epoch);
+
+        // The destructor stops the background reclaimer, executes every
+        // remaining bag (in parallel, if the worker pool is running),
+        // and frees the bags held by the shared free pool.
+        ~global();
+
+        // global::assign_shard()
+        // Returns the shard to which a new participant should push its bags.
+        auto assign_shard() -> usize_t;
+
         // global::push_bag()
-        // Push the bag of deferred functions onto the global queue.
-        auto push_bag(std::unique_ptr<bag>&& b) -> void;
+        // Push the bag of deferred functions onto the given shard's queue.
+        auto push_bag(std::unique_ptr<bag>&& b, usize_t shard) -> void;
 
         // global::collect()
-        // Collects several bags from the global queue of deferred functions
+        // Collects several bags from the global queues of deferred functions
         // and executes the deferred functions within.
-        auto collect() -> void;
+        //
+        // The `home` shard is drained first, then bags are stolen from the
+        // other shards. The number of bags collected adapts to the current
+        // backlog; see global::collect_steps(). Emptied bags are recycled
+        // into `pool` (if not null). Returns the number of bags collected.
+        //
+        // If the worker pool is running, expired bags are handed to it
+        // rather than executed by the calling thread.
+        auto collect(usize_t home, bag_pool* pool) -> usize_t;
+
+        // global::collect(steps)
+        // Collects at most `steps` expired bags, starting with the `home`
+        // shard, and returns the number of bags that were collected.
+        //
+        // If no bags are pending, this returns immediately without
+        // attempting to advance the global epoch.
+        auto collect(usize_t home, usize_t steps, bag_pool* pool) -> usize_t;
+
+        // global::execute_bag()
+        // Executes the deferred functions in the expired bag `b`,
+        // releases its accounted bytes, and recycles it into `pool`.
+        auto execute_bag(std::unique_ptr<bag>&& b, bag_pool* pool) -> void;
+
+        // global::acquire_bag()
+        // Returns an empty bag, taken from `pool` (if not null), then from
+        // the shared free pool; a new bag is allocated only if both are empty.
+        auto acquire_bag(bag_pool* pool) -> std::unique_ptr<bag>;
+
+        // global::recycle_bag()
+        // Returns the empty bag `b` to `pool` (if not null) or else to the
+        // shared free pool. If both are full, the bag is freed.
+        auto recycle_bag(std::unique_ptr<bag>&& b, bag_pool* pool) -> void;
+
+        // global::trim()
+        // Frees all bags in the shared free pool and asks participants to
+        // free the bags in their own pools. Called when the unreclaimed
+        // bytes cross the byte threshold, and by collector::trim().
+        // Returns the number of bags freed from the shared pool.
+        auto trim() -> usize_t;
+
+        // global::account_bytes()
+        // Adds `bytes` to the count of unreclaimed bytes; called with the
+        // bytes of a bag as it is sealed. Returns `true` if this pushed
+        // the count across the byte threshold.
+        auto account_bytes(usize_t bytes) noexcept -> bool;
+
+        // global::unreclaimed()
+        // Returns the approximate number of unreclaimed bytes.
+        auto unreclaimed() const noexcept -> usize_t;
+
+        // global::is_under_pressure()
+        // Returns `true` if the unreclaimed bytes exceed the byte threshold.
+        auto is_under_pressure() const noexcept -> bool;
+
+        // global::pending()
+        // Returns an estimate of the garbage backlog seen from `shard`: the
+        // number of bags in that shard, or one if only other shards have bags.
+        auto pending(usize_t shard) const noexcept -> usize_t;
+
+        // global::pending()
+        // Returns the approximate total number of bags across all shards.
+        auto pending() const noexcept -> usize_t;
+
+        // global::collect_steps()
+        // Returns the number of bags to collect given a backlog of `pending`
+        // bags: COLLECT_STEPS for a small backlog, growing linearly with the
+        // backlog up to MAX_COLLECT_STEPS.
+        static auto collect_steps(usize_t pending) noexcept -> usize_t;
 
         // global::try_advance()
         // Attempts to advance the global epoch.
         //
         // The epoch only advances if all currently pinned participants
-        // have been pinned in the current epoch.
+        // have been pinned in the current epoch. The advance is a
+        // compare-and-swap so that it is also safe to call from a thread
+        // that is not pinned (e.g. the background reclaimer).
+        //
+        // With asymmetric fences, the scan of local epochs is preceded by
+        // membarrier() rather than a sequentially consistent fence.
+        //
+        // The scan also feeds the stalled-participant watchdog.
         auto try_advance() -> epoch;
+
+        // global::synchronize()
+        // Blocks until every participant that is pinned when this is
+        // called has unpinned; see collector::synchronize().
+        auto synchronize(bool expedited) -> void;
+
+        // global::after_grace_period()
+        // Executes `d` once every participant that is pinned when this is
+        // called has unpinned, on whichever thread collects it.
+        auto after_grace_period(deferred&& d) -> void;
+
+        // global::stats()
+        // Returns a snapshot of the collector's statistics.
+        auto stats() -> collector_stats;
+
+        // global::get_fence_mode()
+        // Returns the fence mode in effect for this collector.
+        auto get_fence_mode() const noexcept -> fence_mode;
+
+        // global::get_scheme()
+        auto get_scheme() const noexcept -> scheme;
+
+    private:
+        // global::drain()
+        // Executes every bag left in the shards, expired or not.
+        // Only valid once no participant remains.
+        auto drain() -> void;
+
+        // global::shard_at()
+        auto shard_at(usize_t index) const noexcept -> garbage_shard&;
     };
 }
 
-#endif // EPIC_GLOBAL_H
\ No newline at end of file
+#endif // EPIC_GLOBAL_H
@@ -0,0 +1,91 @@
+// grace.hpp
+
+#ifndef EPIC_GRACE_H
+#define EPIC_GRACE_H
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+#include "type_alias.hpp"
+
+namespace epic
+{
+    struct global;
+
+    // epic::grace_periods
+    //
+    // Waits for grace periods on behalf of collector::synchronize().
+    //
+    // A grace period has elapsed once the global epoch has advanced twice
+    // since the wait began: every participant that was pinned at that
+    // point has unpinned since. Concurrent callers share the work: one of
+    // them drives global::try_advance() while the others sleep, so that
+    // N callers that start together wait for one grace period, not N.
+    //
+    // It also owns the eventfd that asynchronous grace-period requests
+    // signal on completion (see collector::request_grace_period()).
+    class grace_periods
+    {
+    public:
+        // The interval between attempts to advance the epoch
+        // when no caller asked for an expedited grace period.
+        constexpr static auto const POLL_INTERVAL = std::chrono::milliseconds{1};
+
+        // The time an expedited driver sleeps between attempts once it
+        // has exhausted its backoff, i.e. while a straggler stays pinned.
+        constexpr static auto const STRAGGLER_SLEEP = std::chrono::microseconds{50};
+
+    private:
+        std::mutex lock;
+
+        // Signalled when the driving caller stops driving.
+        std::condition_variable driver_done;
+
+        // Is a caller driving the epoch forward? Guarded by `lock`.
+        bool driving;
+
+        // The number of callers waiting for an expedited grace period;
+        // while non-zero, the driver advances as fast as it can.
+        atomic_usize_t expedited_waiters;
+
+        // The eventfd signalled on completion of requested grace periods;
+        // -1 until first requested.
+        std::atomic_int event_fd;
+
+    public:
+        grace_periods();
+
+        // The destructor closes the eventfd, if any.
+        ~grace_periods();
+
+        grace_periods(grace_periods const&)            = delete;
+        grace_periods& operator=(grace_periods const&) = delete;
+
+        // grace_periods::wait()
+        // Blocks until every participant of `g` that is pinned when this
+        // is called has unpinned. Must not be called while pinned in `g`.
+        //
+        // If `expedited`, the epoch is advanced eagerly, backing off while
+        // a straggler stays pinned; otherwise once every POLL_INTERVAL.
+        auto wait(global& g, bool expedited) -> void;
+
+        // grace_periods::fd()
+        // Returns the eventfd, creating it on first use.
+        // Returns -1 (and sets errno) if it cannot be created.
+        auto fd() -> int;
+
+        // grace_periods::signal()
+        // Adds one to the counter of the eventfd, making it readable.
+        auto signal() noexcept -> void;
+
+    private:
+        // grace_periods::drive()
+        // Advances the epoch of `g` until `done()` holds.
+        template <typename Done>
+        auto drive(global& g, Done&& done) -> void;
+    };
+}
+
+#endif // EPIC_GRACE_H
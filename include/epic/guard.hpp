@@ -3,8 +3,15 @@
 #ifndef EPIC_GUARD_H
 #define EPIC_GUARD_H
 
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+
 #include "shared.hpp"
 #include "deferred.hpp"
+#include "backpressure.hpp"
 
 namespace epic
 {   
@@ -47,6 +54,37 @@ namespace epic
         // the destructor for a `guard` unpins the thread that it has pinned.
         ~guard();
 
+        // A `guard` is non-copyable; moving a guard transfers the
+        // responsibility to unpin and leaves behind a dummy guard.
+        guard(guard const&)            = delete;
+        guard& operator=(guard const&) = delete;
+
+        guard(guard&& g);
+        guard& operator=(guard&& g);
+
+        // guard::protect()
+        // Loads the tagged pointer stored in `src`; used by atomic<T>::load().
+        //
+        // The pin held by the guard already protects every object that is
+        // reachable while it is held, so this is a plain load; the tag mask
+        // is only needed by guards that protect individual pointers.
+        auto protect(atomic_usize_t const& src, std::memory_order order,
+            usize_t const) const noexcept -> usize_t
+        {
+            return src.load(order);
+        }
+
+        // guard::hold()
+        // Keeps `ptr` protected for as long as the result lives. The pin
+        // already protects every pointer loaded under the guard, so this
+        // is a no-op; it lets code templated on the collector type run
+        // under hp_collector as well (see hp_guard::hold()).
+        template <typename T>
+        auto hold(shared<T> const&) const noexcept -> no_hold
+        {
+            return no_hold{};
+        }
+
         // guard::defer()
         // Stores a function so that it will be executed at some point
         // after all currently pinned threads are unpinned.
@@ -66,7 +104,26 @@ namespace epic
         //
         // If this method is called from a dummy guard produced by a call
         // to epic::unprotected(), the function is executed immediately.
-        auto defer(std::function<void()>&& f) -> void;
+        //
+        // The callable is stored inline in a `deferred` (no heap allocation)
+        // provided it fits in deferred::DATA_WORDS machine words.
+        //
+        // If `f` releases memory, pass its size as `bytes`: the collector
+        // tracks unreclaimed bytes and collects eagerly once they exceed
+        // its byte threshold (see collector::set_byte_threshold()).
+        //
+        // If the collector has a garbage cap (see collector::set_garbage_cap())
+        // and it is reached, the collector's backpressure policy applies.
+        // Under backpressure::reject, `f` is left untouched and
+        // defer_status::would_exceed is returned.
+        template <typename F, typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<F>, deferred>>>
+        auto defer(F&& f, usize_t bytes = 0) -> defer_status;
+
+        // guard::defer(deferred)
+        // Stores an already-constructed deferred function;
+        // otherwise identical to guard::defer() above.
+        auto defer(deferred&& d, usize_t bytes = 0) -> defer_status;
 
         // guard::defer_destroy()
         // Stores a destructor for an object so that it can be deallocated
@@ -83,8 +140,49 @@ namespace epic
         // threads are unpinned. In theory, the destructor might never run, but
         // the epoch-based garbage collection scheme makes an effort to ensure
         // that it does reasonably soon.
+        //
+        // The deferred destructor is a bare function pointer and the address
+        // of the pointee; it never requires a heap allocation.
+        //
+        // As with guard::defer(), `bytes` declares the memory released,
+        // and `ptr` is left untouched if defer_status::would_exceed is returned.
         template <typename T>
-        auto defer_destroy(shared<T>&& ptr) const -> void;
+        auto defer_destroy(shared<T>&& ptr, usize_t bytes = 0) -> defer_status;
+
+        // guard::defer_destroy_range()
+        // Stores destructors for every object in the range [first, last)
+        // of `shared<T>`s, which together release `bytes` bytes.
+        //
+        // Each pointee gets its own destructor, as with defer_destroy(); they
+        // are passed to the thread-local bag in chunks of RANGE_CHUNK through
+        // a stack array, so nothing is allocated, and the backpressure policy
+        // is applied once for the whole range. Null pointers are skipped.
+        //
+        // `It` must be a forward iterator: the length of the range is needed
+        // to divide `bytes` among the bags that receive the destructors.
+        template <typename It>
+        auto defer_destroy_range(It first, It last, usize_t bytes = 0) -> defer_status;
+
+        // guard::defer_destroy_chain()
+        // Stores a destructor for a pre-linked chain of objects starting at
+        // `head`, which together release `bytes` bytes.
+        //
+        // `next` is invoked on each object (before it is dropped) and must
+        // return a `shared<T>` to its successor in the chain, or a null one
+        // at the end. The chain must already be unlinked from any shared
+        // structure. Like defer_destroy_range(), this is a single deferred
+        // function, and it never allocates if `next` is stateless.
+        template <typename T, typename Next>
+        auto defer_destroy_chain(shared<T>&& head, Next&& next, usize_t bytes = 0) -> defer_status;
+
+        // guard::defer_batch()
+        // Stores the deferred functions in [first, last), which together
+        // release `bytes` bytes, moving them out of the array.
+        //
+        // The thread-local bag is filled in bulk, and the backpressure policy
+        // is applied once for the whole batch. If defer_status::would_exceed
+        // is returned, none of the functions were moved.
+        auto defer_batch(deferred* first, deferred* last, usize_t bytes = 0) -> defer_status;
 
         // guard::flush()
         // Clears the thread-local cache of functions by executing them
@@ -145,9 +243,133 @@ namespace epic
         // The most common use of this function is to produce a dummy
         // guard that is used for constructed or destructing a data structure.
         static auto unprotected() -> guard;
+
+    private:
+        // The number of destructors defer_destroy_range() builds on the stack at once.
+        constexpr static usize_t const RANGE_CHUNK = 32;
+
+        // guard::make_room()
+        // Applies the backpressure policy ahead of deferring a function;
+        // returns `false` if the function must not be deferred.
+        auto make_room() -> bool;
+
+        // guard::defer_unchecked()
+        // Defers `d` (or invokes it, for a dummy guard) once room was made.
+        auto defer_unchecked(deferred&& d, usize_t bytes) -> void;
+
+        // guard::defer_many_unchecked()
+        // Defers the `n` functions starting at `first` (or invokes them,
+        // for a dummy guard) once room was made.
+        auto defer_many_unchecked(deferred* first, usize_t n, usize_t bytes) -> void;
     };
 
+    template <typename F, typename>
+    auto guard::defer(F&& f, usize_t const bytes) -> defer_status
+    {
+        if (is_dummy())
+        {
+            // immediately invoke the deferred function for dummy guards
+            f();
+        }
+        else
+        {
+            if (!make_room())
+            {
+                return defer_status::would_exceed;
+            }
+
+            defer_unchecked(deferred{std::forward<F>(f)}, bytes);
+        }
+
+        return defer_status::ok;
+    }
+
+    template <typename T>
+    auto guard::defer_destroy(shared<T>&& ptr, usize_t const bytes) -> defer_status
+    {
+        if (!make_room())
+        {
+            return defer_status::would_exceed;
+        }
+
+        // `shared<T>` does not destroy its pointee on destruction; the
+        // deferred function drops the (untagged) pointee via pointable<T>
+        auto const [raw, tag] = decompose_tag<T>(ptr.into_usize());
+        defer_unchecked(deferred::make_destroy<T>(raw), bytes);
+
+        return defer_status::ok;
+    }
+
+    template <typename It>
+    auto guard::defer_destroy_range(It first, It last, usize_t const bytes) -> defer_status
+    {
+        using T = typename std::iterator_traits<It>::value_type::element_type;
+
+        static_assert(std::is_base_of_v<std::forward_iterator_tag,
+            typename std::iterator_traits<It>::iterator_category>,
+            "defer_destroy_range() requires a forward iterator");
+
+        if (first == last)
+        {
+            return defer_status::ok;
+        }
+
+        if (!make_room())
+        {
+            return defer_status::would_exceed;
+        }
+
+        auto remaining    = static_cast<usize_t>(std::distance(first, last));
+        auto unattributed = bytes;
+
+        std::array<deferred, RANGE_CHUNK> chunk;
+        while (0 != remaining)
+        {
+            // The pointers consumed by this chunk, including null ones.
+            auto consumed = 0ul;
+            auto filled   = 0ul;
+            for (; first != last && filled < RANGE_CHUNK; ++first, ++consumed)
+            {
+                auto const [raw, tag] = decompose_tag<T>(shared<T>{*first}.into_usize());
+                if (0 != raw)
+                {
+                    chunk[filled++] = deferred::make_destroy<T>(raw);
+                }
+            }
+
+            auto const share = bytes_share(unattributed, consumed, remaining);
+            defer_many_unchecked(chunk.data(), filled, share);
+
+            unattributed -= share;
+            remaining    -= consumed;
+        }
+
+        return defer_status::ok;
+    }
+
+    template <typename T, typename Next>
+    auto guard::defer_destroy_chain(shared<T>&& head, Next&& next, usize_t const bytes) -> defer_status
+    {
+        if (!make_room())
+        {
+            return defer_status::would_exceed;
+        }
+
+        auto const [raw, tag] = decompose_tag<T>(head.into_usize());
+        defer_unchecked(deferred{[raw = raw, next = std::forward<Next>(next)]() mutable
+        {
+            for (auto current = raw; 0 != current;)
+            {
+                auto successor = next(pointable<T>::deref_mut(current));
+                auto const [succ, succ_tag] = decompose_tag<T>(successor.into_usize());
+
+                pointable<T>::drop(current);
+                current = succ;
+            }
+        }}, bytes);
 
+        return defer_status::ok;
+    }
 }
 
 #endif // EPIC_GUARD_H
\ No newline at end of file
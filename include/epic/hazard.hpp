@@ -0,0 +1,276 @@
+// hazard.hpp
+
+#ifndef EPIC_HAZARD_H
+#define EPIC_HAZARD_H
+
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "pointer.hpp"
+#include "type_alias.hpp"
+#include "cache_padded.hpp"
+
+namespace epic
+{
+    // epic::retired_ptr
+    //
+    // An object retired under hazard-pointer reclamation: its untagged
+    // address and the function that drops it.
+    struct retired_ptr
+    {
+        usize_t raw;
+        void (*drop)(usize_t);
+    };
+
+    // epic::hazard_record
+    //
+    // The hazard pointers published by a single participant.
+    //
+    // Each record fills a cache line, since its owner writes it on every
+    // protected load while scanning threads read it.
+    struct alignas(CACHE_LINE_SIZE) hazard_record
+    {
+        // The number of hazard pointers per participant used in turn by loads.
+        constexpr static usize_t const SLOTS = 8;
+
+        // The number of hazard pointers per participant for explicit holds.
+        constexpr static usize_t const HOLDS = 8;
+
+        // The protected (untagged) addresses; 0 if a slot is unused.
+        std::array<atomic_usize_t, SLOTS> hazards;
+
+        // The addresses protected by holds (see hp_guard::hold()), which
+        // are not reused until released; 0 if a slot is unused.
+        std::array<atomic_usize_t, HOLDS> held;
+
+        // Is this record owned by a participant?
+        std::atomic_bool active;
+
+        // The next record in the domain; immutable once published.
+        hazard_record* next;
+
+        hazard_record();
+
+        // hazard_record::clear()
+        // Releases every hazard pointer used by loads; holds are kept.
+        auto clear() noexcept -> void;
+    };
+
+    // epic::hazard_domain
+    //
+    // The global state of a hazard-pointer collector: the list of hazard
+    // records, and the objects retired by participants that have since
+    // been finalized.
+    //
+    // Hazard pointers bound the garbage that a stalled reader can hold
+    // back to the objects it protects, where a pinned participant under
+    // epoch-based reclamation holds back everything retired since.
+    class hazard_domain
+    {
+        // The head of the (grow-only) list of hazard records.
+        std::atomic<hazard_record*> head;
+
+        // The number of records in the list.
+        atomic_usize_t record_count;
+
+        // Objects retired by finalized participants, adopted by the
+        // next participant that scans.
+        std::mutex orphan_lock;
+        std::vector<retired_ptr> orphans;
+
+    public:
+        hazard_domain();
+
+        // The destructor drops every orphaned object; no participant
+        // (and therefore no hazard pointer) may remain.
+        ~hazard_domain();
+
+        hazard_domain(hazard_domain const&)            = delete;
+        hazard_domain& operator=(hazard_domain const&) = delete;
+
+        // hazard_domain::participants()
+        // Returns the number of hazard records allocated.
+        auto participants() const noexcept -> usize_t;
+
+        // hazard_domain::acquire_record()
+        // Acquires an inactive hazard record, or allocates a new one.
+        auto acquire_record() -> hazard_record&;
+
+        // hazard_domain::release_record()
+        // Clears `r` and releases it for reuse by another participant.
+        auto release_record(hazard_record& r) noexcept -> void;
+
+        // hazard_domain::scan_threshold()
+        // Returns the number of retired objects at which a participant
+        // scans the hazard pointers: twice the number of hazard pointers,
+        // so that each scan reclaims at least half of the objects.
+        auto scan_threshold() const noexcept -> usize_t;
+
+        // hazard_domain::collect_hazards()
+        // Replaces the contents of `out` with the published hazard
+        // pointers, sorted.
+        auto collect_hazards(std::vector<usize_t>& out) const -> void;
+
+        // hazard_domain::orphan()
+        // Takes over the retired objects of a finalized participant.
+        auto orphan(std::vector<retired_ptr>&& retired) -> void;
+
+        // hazard_domain::adopt_orphans()
+        // Moves the orphaned objects into `retired`, unless another
+        // participant is doing so concurrently.
+        auto adopt_orphans(std::vector<retired_ptr>& retired) -> void;
+    };
+
+    class hazard_local;
+
+    // epic::hazard_hold
+    //
+    // A pointer protected by a dedicated hazard pointer of its participant,
+    // as returned by hp_guard::hold(); the hazard pointer is released when
+    // the hold is dropped.
+    class hazard_hold
+    {
+        hazard_local* local_ptr;
+        usize_t index;
+
+    public:
+        hazard_hold();
+
+        hazard_hold(hazard_local* local_ptr_, usize_t index_);
+
+        // The destructor releases the hazard pointer.
+        ~hazard_hold();
+
+        hazard_hold(hazard_hold const&)            = delete;
+        hazard_hold& operator=(hazard_hold const&) = delete;
+
+        hazard_hold(hazard_hold&& h);
+        hazard_hold& operator=(hazard_hold&& h);
+    };
+
+    // epic::hazard_local
+    //
+    // The state of a participant in a hazard-pointer collector: its hazard
+    // record and its list of retired objects. Owned by an hp_handle.
+    class hazard_local
+    {
+        hazard_domain& domain;
+
+        // The hazard pointers of this participant.
+        hazard_record& record;
+
+        // The objects retired by this participant and not yet dropped.
+        std::vector<retired_ptr> retired;
+
+        // The protected addresses observed by the last scan.
+        std::vector<usize_t> scratch;
+
+        // The number of guards of this participant.
+        usize_t guard_count;
+
+        // The hazard pointer to use for the next protected load.
+        usize_t next_slot;
+
+        // The bitmask of the hold slots in use.
+        usize_t holds_in_use;
+
+        // The number of protections dropped by reusing a hazard pointer
+        // while a guard was held.
+        usize_t overwrites;
+
+    public:
+        // The result of hp_guard::hold().
+        using hold_type = hazard_hold;
+
+        explicit hazard_local(hazard_domain& domain_);
+
+        // The destructor releases the hazard record, scans once more,
+        // and hands any objects that are still protected to the domain.
+        ~hazard_local();
+
+        hazard_local(hazard_local const&)            = delete;
+        hazard_local& operator=(hazard_local const&) = delete;
+
+        // hazard_local::enter()
+        auto enter() noexcept -> void;
+
+        // hazard_local::leave()
+        // Releases every hazard pointer once the last guard is dropped.
+        auto leave() noexcept -> void;
+
+        // hazard_local::protect()
+        // Loads the tagged pointer in `src` and protects its pointee;
+        // `tag_mask` selects the tag bits of the pointer.
+        //
+        // The pointer is published in the next hazard pointer in turn and
+        // `src` is reloaded until it is unchanged, at which point the
+        // pointee cannot have been retired before the hazard was visible.
+        auto protect(atomic_usize_t const& src, std::memory_order order,
+            usize_t const tag_mask) noexcept -> usize_t
+        {
+            auto& hazard = record.hazards[next_slot];
+            next_slot = (next_slot + 1) % hazard_record::SLOTS;
+
+            // Any pointer still held in this slot loses its protection.
+            if (0 != hazard.load(std::memory_order_relaxed))
+            {
+                ++overwrites;
+            }
+
+            auto current = src.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                hazard.store(current & ~tag_mask, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                auto const validated = src.load(order);
+                if (validated == current)
+                {
+                    return current;
+                }
+
+                current = validated;
+            }
+        }
+
+        // hazard_local::hold()
+        // Protects the (untagged) address `raw`, which a load must currently
+        // protect, in a hold slot until hazard_local::release(). Returns the
+        // index of the slot; throws if every hold slot is in use.
+        auto hold(usize_t raw) -> usize_t;
+
+        // hazard_local::release()
+        // Releases the hold slot `index`.
+        auto release(usize_t index) noexcept -> void;
+
+        // hazard_local::overwritten()
+        // Returns the number of protections dropped because a hazard pointer
+        // was reused by a later load; see hp_guard::hold().
+        auto overwritten() const noexcept -> usize_t;
+
+        // hazard_local::retire()
+        // Retires an object; it is dropped once no hazard protects it.
+        auto retire(retired_ptr r) -> void;
+
+        // hazard_local::retire<T>()
+        // Retires the object of type T at the (untagged) address `raw`.
+        template <typename T>
+        auto retire(usize_t const raw) -> void
+        {
+            retire(retired_ptr{raw, &pointable<T>::drop});
+        }
+
+        // hazard_local::scan()
+        // Drops every retired object that no hazard pointer protects.
+        // Returns the number of objects dropped.
+        auto scan() -> usize_t;
+
+        // hazard_local::pending()
+        // Returns the number of retired objects not yet dropped.
+        auto pending() const noexcept -> usize_t;
+    };
+}
+
+#endif // EPIC_HAZARD_H
@@ -0,0 +1,37 @@
+// hp_collector.hpp
+
+#ifndef EPIC_HP_COLLECTOR_H
+#define EPIC_HP_COLLECTOR_H
+
+#include "hazard.hpp"
+#include "hp_guard.hpp"
+#include "basic_collector.hpp"
+
+namespace epic
+{
+    // epic::hp_collector
+    //
+    // A hazard-pointer garbage collector instance.
+    //
+    // Data structure code written against the epic::collector API can be
+    // templated on the collector type:
+    //
+    //     template <typename Collector>
+    //     class stack { ... };
+    //
+    //     stack<epic::collector>    ebr;  // epoch-based reclamation
+    //     stack<epic::hp_collector> hp;   // hazard pointers
+    //
+    // Hazard pointers cost a fence on every protected load, but a stalled
+    // reader holds back only the objects it protects, where a pinned
+    // participant holds back every object retired since it pinned.
+    // Only defer_destroy() is supported, not arbitrary deferred functions.
+    using hp_collector = basic_collector<hazard_domain, hazard_local>;
+
+    // epic::hp_handle
+    //
+    // A participant in a hazard-pointer collector.
+    using hp_handle = basic_handle<hazard_domain, hazard_local>;
+}
+
+#endif // EPIC_HP_COLLECTOR_H
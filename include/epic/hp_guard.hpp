@@ -0,0 +1,43 @@
+// hp_guard.hpp
+
+#ifndef EPIC_HP_GUARD_H
+#define EPIC_HP_GUARD_H
+
+#include "hazard.hpp"
+#include "basic_guard.hpp"
+
+namespace epic
+{
+    // epic::hp_guard
+    //
+    // The guard of a hazard-pointer collector (see hp_collector).
+    //
+    // atomic::load() with an hp_guard publishes a hazard pointer for the
+    // loaded pointer instead of relying on a pinned epoch, and
+    // hp_guard::defer_destroy() retires the object to the participant's
+    // list, which is scanned against the hazard pointers once it grows.
+    //
+    // Protection
+    //
+    // The guards of a participant share hazard_record::SLOTS hazard pointers,
+    // used in turn: a `shared<T>` returned by a load stays protected until
+    // that many further loads have been made (or the last guard of the
+    // participant is dropped). This covers hand-over-hand traversals, which
+    // hold a few pointers at a time. Pointers returned by the other
+    // operations of atomic<T> (swap, compare_and_set, fetch_*) are not
+    // protected.
+    //
+    // Code that keeps a pointer across more loads than that (e.g. the
+    // predecessors of a skiplist search) must hold it with hp_guard::hold(),
+    // which protects it in a dedicated hazard pointer until the returned
+    // hazard_hold is dropped. The pointer must have been loaded under the
+    // guard within the last hazard_record::SLOTS loads, at most
+    // hazard_record::HOLDS pointers may be held at once by a participant,
+    // and a hold must not outlive its handle. guard::hold() is a no-op, so
+    // such code still runs under epoch-based reclamation. Protections
+    // dropped by reuse are counted by hp_handle::overwritten(), which a
+    // test can check.
+    using hp_guard = basic_guard<hazard_local>;
+}
+
+#endif // EPIC_HP_GUARD_H
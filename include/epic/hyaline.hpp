@@ -0,0 +1,113 @@
+// hyaline.hpp
+
+#ifndef EPIC_HYALINE_H
+#define EPIC_HYALINE_H
+
+#include <atomic>
+#include <memory>
+
+#include "bag.hpp"
+#include "bag_pool.hpp"
+#include "type_alias.hpp"
+
+namespace epic
+{
+    struct global;
+
+    // epic::scheme
+    //
+    // The reclamation scheme of an epic::collector; fixed at construction.
+    enum class scheme
+    {
+        // Sealed bags are queued and executed once the global epoch
+        // has advanced twice; advancing the epoch scans every participant.
+        epoch,
+
+        // Sealed bags are reference-counted by the participants that were
+        // pinned when they were sealed, and executed by the last of them
+        // to unpin; there is no global epoch and no scan (see hyaline_domain).
+        hyaline
+    };
+
+    struct hyaline_batch;
+
+    // epic::hyaline_node
+    //
+    // The link of a batch in the list of one pinned participant.
+    struct hyaline_node
+    {
+        hyaline_batch* batch;
+        hyaline_node* next;
+    };
+
+    // epic::hyaline_batch
+    //
+    // A sealed bag, published to the lists of the participants that were
+    // pinned when it was sealed, one node per participant.
+    struct hyaline_batch
+    {
+        std::unique_ptr<bag> contents;
+
+        // The number of participants that have yet to unpin. May drop
+        // below zero while the batch is being published; see retire().
+        std::atomic<isize_t> refs;
+
+        std::unique_ptr<hyaline_node[]> nodes;
+
+        hyaline_batch(std::unique_ptr<bag>&& contents_, usize_t node_count);
+    };
+
+    // epic::hyaline_domain
+    //
+    // The state of a collector that uses scheme::hyaline; after "Hyaline"
+    // (Nikolaev and Ravindran), in its single-width variant with one list
+    // per participant.
+    //
+    // Each registry slot holds the head of a list of batches, whose low bit
+    // marks the participant as pinned. Sealing a bag links one node of the
+    // new batch into the list of every pinned participant and sets the
+    // batch's reference count to the number of lists it entered. Unpinning
+    // detaches the participant's list and drops a reference to each batch
+    // in it; the participant that drops the last reference executes the bag.
+    //
+    // Nothing ever scans the participants to advance an epoch, so the cost
+    // of reclamation does not depend on how many threads have registered;
+    // sealing a bag only visits the occupied slots, and unpinned or
+    // exited participants hold back nothing.
+    class hyaline_domain
+    {
+        global& owner;
+
+    public:
+        // The bit of a list head that marks its participant as pinned.
+        constexpr static usize_t const ACTIVE = 1;
+
+        explicit hyaline_domain(global& owner_);
+
+        hyaline_domain(hyaline_domain const&)            = delete;
+        hyaline_domain& operator=(hyaline_domain const&) = delete;
+
+        // hyaline_domain::enter()
+        // Marks the participant whose list starts at `head` as pinned.
+        auto enter(atomic_usize_t& head) noexcept -> void;
+
+        // hyaline_domain::leave()
+        // Marks the participant as unpinned and releases the batches sealed
+        // while it was pinned, executing those it was the last to hold;
+        // their bags are recycled into `pool` (if not null).
+        auto leave(atomic_usize_t& head, bag_pool* pool) -> void;
+
+        // hyaline_domain::retire()
+        // Publishes the sealed bag `b` to every pinned participant, or
+        // executes it at once if no participant is pinned.
+        auto retire(std::unique_ptr<bag>&& b, bag_pool* pool) -> void;
+
+    private:
+        // hyaline_domain::release()
+        // Drops `n` references to `b`, executing and freeing it if they
+        // were the last.
+        auto release(hyaline_batch* b, isize_t n, bag_pool* pool) -> void;
+    };
+}
+
+#endif // EPIC_HYALINE_H
@@ -0,0 +1,245 @@
+// ibr.hpp
+
+#ifndef EPIC_IBR_H
+#define EPIC_IBR_H
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+#include "era.hpp"
+#include "base.hpp"
+#include "pointer.hpp"
+#include "type_alias.hpp"
+#include "cache_padded.hpp"
+
+namespace epic
+{
+    // epic::retired_block
+    //
+    // An object retired under interval-based reclamation: its untagged
+    // address, the function that drops it, and its lifetime in eras.
+    struct retired_block
+    {
+        usize_t raw;
+        void (*drop)(usize_t);
+        usize_t birth_era;
+        usize_t retire_era;
+    };
+
+    // epic::era_reservation
+    //
+    // The interval of eras reserved by a participant.
+    struct era_reservation
+    {
+        usize_t lower;
+        usize_t upper;
+
+        // era_reservation::overlaps()
+        // Determines if the lifetime of `b` intersects this reservation.
+        auto overlaps(retired_block const& b) const noexcept -> bool
+        {
+            return b.birth_era <= upper && lower <= b.retire_era;
+        }
+    };
+
+    // epic::era_record
+    //
+    // The era interval reserved by a single participant.
+    //
+    // Each record fills a cache line, since its owner writes it whenever
+    // the era changes under one of its loads while scanning threads read it.
+    struct alignas(CACHE_LINE_SIZE) era_record
+    {
+        // The bound of an empty reservation.
+        constexpr static usize_t const NONE = USIZE_MAX;
+
+        // The reserved interval [lower, upper]; NONE if the owner is not in
+        // a read phase. `lower` is written once per read phase, while
+        // `upper` is extended lazily by loads.
+        atomic_usize_t lower;
+        atomic_usize_t upper;
+
+        // Is this record owned by a participant?
+        std::atomic_bool active;
+
+        // The next record in the domain; immutable once published.
+        era_record* next;
+
+        era_record();
+
+        // era_record::clear()
+        // Releases the reservation.
+        auto clear() noexcept -> void;
+    };
+
+    // epic::era_domain
+    //
+    // The global state of an interval-based collector: the list of era
+    // records, and the objects retired by participants that have since
+    // been finalized.
+    class era_domain
+    {
+        // The head of the (grow-only) list of era records.
+        std::atomic<era_record*> head;
+
+        // The number of records in the list.
+        atomic_usize_t record_count;
+
+        // Objects retired by finalized participants, adopted by the
+        // next participant that scans.
+        std::mutex orphan_lock;
+        std::vector<retired_block> orphans;
+
+    public:
+        era_domain();
+
+        // The destructor drops every orphaned object; no participant
+        // (and therefore no reservation) may remain.
+        ~era_domain();
+
+        era_domain(era_domain const&)            = delete;
+        era_domain& operator=(era_domain const&) = delete;
+
+        // era_domain::participants()
+        // Returns the number of era records allocated.
+        auto participants() const noexcept -> usize_t;
+
+        // era_domain::acquire_record()
+        // Acquires an inactive era record, or allocates a new one.
+        auto acquire_record() -> era_record&;
+
+        // era_domain::release_record()
+        // Clears `r` and releases it for reuse by another participant.
+        auto release_record(era_record& r) noexcept -> void;
+
+        // era_domain::collect_reservations()
+        // Replaces the contents of `out` with the published reservations.
+        auto collect_reservations(std::vector<era_reservation>& out) const -> void;
+
+        // era_domain::orphan()
+        // Takes over the retired objects of a finalized participant.
+        auto orphan(std::vector<retired_block>&& retired) -> void;
+
+        // era_domain::adopt_orphans()
+        // Moves the orphaned objects into `retired`, unless another
+        // participant is doing so concurrently.
+        auto adopt_orphans(std::vector<retired_block>& retired) -> void;
+    };
+
+    // epic::era_local
+    //
+    // The state of a participant in an interval-based collector: its era
+    // record and its list of retired objects. Owned by an ibr_handle.
+    class era_local
+    {
+    public:
+        // The number of objects a participant retires before it
+        // advances the era clock.
+        constexpr static usize_t const ERA_FREQUENCY = 32;
+
+        // The number of retired objects at which a participant scans
+        // the reservations.
+        constexpr static usize_t const SCAN_THRESHOLD = 128;
+
+    private:
+        era_domain& domain;
+
+        // The reservation of this participant.
+        era_record& record;
+
+        // The objects retired by this participant and not yet dropped.
+        std::vector<retired_block> retired;
+
+        // The reservations observed by the last scan.
+        std::vector<era_reservation> scratch;
+
+        // The number of guards of this participant.
+        usize_t guard_count;
+
+        // The number of objects retired by this participant.
+        usize_t retire_count;
+
+    public:
+        // The result of ibr_guard::hold(): a reservation already protects
+        // every pointer loaded under it until the last guard is dropped.
+        using hold_type = no_hold;
+
+        explicit era_local(era_domain& domain_);
+
+        // The destructor releases the era record, scans once more,
+        // and hands any objects that are still reserved to the domain.
+        ~era_local();
+
+        era_local(era_local const&)            = delete;
+        era_local& operator=(era_local const&) = delete;
+
+        // era_local::enter()
+        // Reserves the current era when the first guard is created.
+        auto enter() noexcept -> void;
+
+        // era_local::leave()
+        // Releases the reservation once the last guard is dropped.
+        auto leave() noexcept -> void;
+
+        // era_local::protect()
+        // Loads the tagged pointer in `src`, extending the upper bound
+        // of the reservation to the current era if necessary.
+        //
+        // `src` is reloaded until the era is unchanged across the load: the
+        // pointee was then born no later than the reserved upper bound, and
+        // cannot be retired before the reservation is visible. Eras do not
+        // depend on addresses, so the tag mask is not needed.
+        auto protect(atomic_usize_t const& src, std::memory_order order, usize_t const) noexcept -> usize_t
+        {
+            auto& clock = era_clock();
+            auto upper  = record.upper.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto const current = src.load(order);
+                auto const era     = clock.load(std::memory_order_acquire);
+                if (era == upper)
+                {
+                    return current;
+                }
+
+                upper = era;
+                record.upper.store(era, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        // era_local::retire()
+        // Retires an object; it is dropped once its lifetime
+        // no longer overlaps any reservation.
+        auto retire(retired_block b) -> void;
+
+        // era_local::retire<T>()
+        // Retires the object of type T at the (untagged) address `raw`.
+        template <typename T>
+        auto retire(usize_t const raw) -> void
+        {
+            auto const born = birth_era(reinterpret_cast<T const*>(raw));
+            retire(retired_block{raw, &pointable<T>::drop, born, 0});
+        }
+
+        // era_local::scan()
+        // Drops every retired object whose lifetime does not overlap
+        // a reservation. Returns the number of objects dropped.
+        auto scan() -> usize_t;
+
+        // era_local::pending()
+        // Returns the number of retired objects not yet dropped.
+        auto pending() const noexcept -> usize_t;
+
+        // era_local::overwritten()
+        // Returns zero: a reservation never drops the protection of a
+        // pointer loaded under it (cf. hazard_local::overwritten()).
+        auto overwritten() const noexcept -> usize_t
+        {
+            return 0;
+        }
+    };
+}
+
+#endif // EPIC_IBR_H
@@ -0,0 +1,36 @@
+// ibr_collector.hpp
+
+#ifndef EPIC_IBR_COLLECTOR_H
+#define EPIC_IBR_COLLECTOR_H
+
+#include "ibr.hpp"
+#include "ibr_guard.hpp"
+#include "basic_collector.hpp"
+
+namespace epic
+{
+    // epic::ibr_collector
+    //
+    // An interval-based (IBR) garbage collector instance, after the
+    // "2GE-IBR" scheme of Wen et al.
+    //
+    // Objects carry their birth era (see epic::era_stamped) and are stamped
+    // with their retire era when retired. A participant reserves the interval
+    // of eras spanned by its read phase, and an object is dropped once its
+    // lifetime [birth, retire] overlaps no reservation.
+    //
+    // It has the shape of epic::collector and epic::hp_collector, so data
+    // structure code can be templated on the collector type. Loads cost no
+    // fence unless the era has moved on; like hazard pointers, and unlike
+    // epochs, a stalled reader cannot hold back objects allocated after its
+    // last load. Only defer_destroy() is supported, not arbitrary deferred
+    // functions.
+    using ibr_collector = basic_collector<era_domain, era_local>;
+
+    // epic::ibr_handle
+    //
+    // A participant in an interval-based collector.
+    using ibr_handle = basic_handle<era_domain, era_local>;
+}
+
+#endif // EPIC_IBR_COLLECTOR_H
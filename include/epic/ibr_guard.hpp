@@ -0,0 +1,31 @@
+// ibr_guard.hpp
+
+#ifndef EPIC_IBR_GUARD_H
+#define EPIC_IBR_GUARD_H
+
+#include "ibr.hpp"
+#include "basic_guard.hpp"
+
+namespace epic
+{
+    // epic::ibr_guard
+    //
+    // The guard of an interval-based collector (see ibr_collector).
+    //
+    // The first guard of a participant reserves the current era, and
+    // atomic::load() with an ibr_guard extends the reservation to the
+    // current era when it has moved on. ibr_guard::defer_destroy() retires
+    // the object to the participant's list, which is scanned against the
+    // reservations once it grows.
+    //
+    // Protection
+    //
+    // Every pointer loaded under a guard stays protected until the last
+    // guard of the participant is dropped, as under epoch-based reclamation;
+    // but a stalled participant holds back only the objects that were alive
+    // during its reservation, not every object retired since. Hence
+    // ibr_guard::hold() is a no-op.
+    using ibr_guard = basic_guard<era_local>;
+}
+
+#endif // EPIC_IBR_GUARD_H
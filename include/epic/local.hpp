@@ -5,12 +5,13 @@
 
 #include "cell.hpp"
 #include "guard.hpp"
+#include "bag_pool.hpp"
 #include "epoch.hpp"
 #include "collector.hpp"
+#include "cache_padded.hpp"
 #include "type_alias.hpp"
 
 #include <memory>
-#include <lowlock/list.hpp>
 
 namespace epic
 {
@@ -19,17 +20,29 @@ namespace epic
     // epic::local
     //
     // A participant in garbage collection.
-    class local
+    //
+    // A `local` is written only by its owning thread; the one field that
+    // other threads read, the local epoch, lives in the global registry.
+    // It is aligned to a cache line so that the participants of different
+    // threads never share a line, and the fields touched by pin() and
+    // unpin() fit within its first line.
+    class alignas(CACHE_LINE_SIZE) local
     {
         // The number of pinnings after which the participant will 
-        // execute some deferred functions from the global queue.
-        static usize_t const PINNINGS_BETWEEN_COLLECT = 128;
+        // execute some deferred functions from the global queue,
+        // when the global backlog of garbage is small.
+        //
+        // Must be a power of two; see local::collect_period().
+        constexpr static usize_t const PINNINGS_BETWEEN_COLLECT = 128;
+
+        // The index of this participant's slot in the global registry.
+        usize_t const slot;
 
-        // An entry in the intrusive linked list of `local`s.
-        lowlock::list_entry entry;
+        // The local epoch, stored in the registry slot.
+        atomic_epoch& local_epoch;
 
-        // The local epoch.
-        atomic_epoch local_epoch;
+        // The statistics counters, stored in the registry slot.
+        participant_counters& counters;
 
         // A reference to the global data.
         collector instance;
@@ -37,6 +50,9 @@ namespace epic
         // The local bag of deferred functions.
         std::unique_ptr<bag> deferreds;
 
+        // The last trim generation of the global data observed.
+        cell<usize_t> trim_seen;
+
         // The number of guards keeping this participant pinned.
         cell<usize_t> guard_count;
 
@@ -47,13 +63,48 @@ namespace epic
         // This is an auxilliary counter that sometimes kicks off collection.
         cell<usize_t> pin_count;
 
+        // Is this a reader-only participant?
+        // Reader-only participants never execute collection inline;
+        // they rely on other participants or the background reclaimer.
+        bool const reader_only;
+
+        // Is this a quiescent-state-based (QSBR) participant?
+        // A QSBR participant stays pinned while it is online, moving its
+        // pinned epoch forward at each call to quiescent(); its guards
+        // then never store to the local epoch.
+        bool const qsbr;
+
+        // Is this QSBR participant online (holding its implicit pin)?
+        cell<bool> online;
+
+        // The garbage shard to which this participant pushes its bags,
+        // and from which it collects first.
+        usize_t const shard;
+
+        // Does this participant publish its epoch with asymmetric fences?
+        // Cached from the global data so that pin() need not load it.
+        bool const asymmetric_fences;
+
+        // The batches of the collector under scheme::hyaline, if any;
+        // cached so that pin() need not load it from the global data.
+        hyaline_domain* const hyaline;
+
+        // The head of this participant's list of batches under
+        // scheme::hyaline, stored in the registry slot.
+        atomic_usize_t& batches;
+
+        // The pool of empty bags recycled by this participant.
+        // Used only when bags are sealed and recycled, not by pin().
+        bag_pool free_bags;
+
     public:
-        local(collector& c);
+        local(collector& c, bool reader_only_, bool qsbr_ = false);
 
         // local::register_handle()
         // Register a new `local` in the `global` associated with
         // the provided `collector` instance.
-        static auto register_handle(collector& c) -> local_handle;
+        static auto register_handle(collector& c, bool reader_only = false,
+            bool qsbr = false) -> local_handle;
 
         // local::get_global()
         auto get_global() const -> global&;
@@ -65,23 +116,92 @@ namespace epic
         // local::get_epoch()
         auto get_epoch() const -> epoch;
 
+        // local::get_slot()
+        // Returns the index of this participant's registry slot.
+        auto get_slot() const noexcept -> usize_t;
+
+        // local::get_guard_count()
+        // Returns the number of guards keeping this participant pinned.
+        auto get_guard_count() const noexcept -> usize_t;
+
         // local::is_pinned()
         // Returns `true` if the current participant is pinned.
         auto is_pinned() const -> bool;
 
+        // local::collect_period()
+        // Returns the number of pinnings between collections given a
+        // global backlog of `pending` bags.
+        //
+        // With no backlog no collection is needed at all (returns 0).
+        // Otherwise the period starts at PINNINGS_BETWEEN_COLLECT and
+        // halves every time the backlog doubles beyond COLLECT_STEPS
+        // bags, down to a collection on every pin.
+        static auto collect_period(usize_t pending) noexcept -> usize_t;
+
+        // local::is_reader_only()
+        // Returns `true` if the participant never collects inline.
+        auto is_reader_only() const noexcept -> bool;
+
         // local::defer()
-        // Adds the deferred function `d` to the thread-local bag.
-        auto defer(deferred&& d, guard& g) -> void;
+        // Adds the deferred function `d`, which releases `bytes` bytes
+        // when executed, to the thread-local bag.
+        //
+        // If this puts the collector under memory pressure, the local bag
+        // is sealed and expired garbage is collected immediately.
+        auto defer(deferred&& d, usize_t bytes, guard& g) -> void;
 
         // local::flush()
         // Flush all local deferred functions to the global cache,
         // and trigger a global collection.
         auto flush(guard& g) -> void;
 
+        // local::defer_many()
+        // Adds the `n` deferred functions starting at `first`, which
+        // together release `bytes` bytes, to the thread-local bag.
+        //
+        // The bag is filled in bulk; every bag that fills up is sealed and
+        // pushed to the global queue without re-checking the others.
+        auto defer_many(deferred* first, usize_t n, usize_t bytes, guard& g) -> void;
+
+        // local::make_room()
+        // Applies the collector's backpressure policy if deferring another
+        // function would seal the local bag while the global backlog is at
+        // the garbage cap. Returns `false` if the function must be rejected.
+        auto make_room() -> bool;
+
+        // local::relieve_pressure()
+        // Seals the local bag if it holds accounted bytes, so that they
+        // become reclaimable, then forces an attempt to advance the epoch
+        // and collects every expired bag (unless reader-only).
+        auto relieve_pressure() -> void;
+
         // local::pin()
         // Pins the `local` instance.
         auto pin() -> guard;
         
+        // local::quiescent()
+        // Reports a quiescent state of a QSBR participant: it holds no
+        // references to shared objects, so its pinned epoch moves forward
+        // to the global epoch. Collects garbage periodically, like pin().
+        auto quiescent() -> void;
+
+        // local::go_offline()
+        // Drops the implicit pin of a QSBR participant, so that it does not
+        // hold back the epoch while it blocks. Guards pin it as usual.
+        auto go_offline() -> void;
+
+        // local::go_online()
+        // Retakes the implicit pin of a QSBR participant.
+        auto go_online() -> void;
+
+        // local::is_qsbr()
+        auto is_qsbr() const noexcept -> bool;
+
+        // local::resume()
+        // Republishes the pinned epoch after the participant was
+        // neutralized (unpinned by a signal) while holding a guard.
+        auto resume() -> void;
+
         // local::unpin()
         // Unpins the `local` instance.
         auto unpin() -> void;
@@ -99,16 +219,45 @@ namespace epic
         auto release_handle() -> void;
 
         // local::finalize()
-        // Removes the `local` instance from the global linked list.
+        // Releases the `local` instance's registry slot and destroys it.
         auto finalize() -> void;
 
-        // local::entry_of()
-        // Return a reference to this list element's embedded entry.
-        static auto entry_of(local& l) -> lowlock::list_entry&;
+        // local::maybe_collect()
+        // Periodically tries to advance the epoch and collect garbage;
+        // called on every outermost pin and quiescent state.
+        auto maybe_collect() -> void;
+
+        // local::publish_pinned()
+        // Stores the current global epoch, marked as pinned, as the local
+        // epoch, with the fences required by the collector's fence mode.
+        // Returns the published epoch.
+        auto publish_pinned() -> epoch;
+
+        // local::seal_bag()
+        // Hands the full bag `b` over for reclamation: to this participant's
+        // garbage shard, or to the pinned participants under scheme::hyaline.
+        //
+        // The bytes in the bag are accounted globally here, once per bag
+        // rather than once per deferred function. Returns `true` if this
+        // pushed the count across the byte threshold, in which case the
+        // bag pools are trimmed (see global::trim()).
+        auto seal_bag(std::unique_ptr<bag>&& b) -> bool;
+
+        // local::crosses_threshold()
+        // Returns `true` if the `bytes` just added to the local bag pushed
+        // the unreclaimed bytes, counting those of the local bag that are
+        // not yet accounted, across the byte threshold.
+        auto crosses_threshold(usize_t bytes) const noexcept -> bool;
+
+        // local::fresh_bag()
+        // Returns an empty bag to replace a sealed one, preferring
+        // recycled bags to allocation.
+        auto fresh_bag() -> std::unique_ptr<bag>;
 
-        // local::element_of()
-        // Given a reference to a list element's entry, return a reference to the element.
-        static auto element_of(lowlock::list_entry& e) -> local&;
+        // local::pool()
+        // Returns this participant's pool of empty bags, after freeing
+        // its contents if the global data has been trimmed since.
+        auto pool() -> bag_pool*;
     };
 }
 
@@ -25,14 +25,41 @@ namespace epic
         // global list of `local`s maintained by the collector.
         ~local_handle();
 
+        // A `local_handle` is non-copyable; moving a handle transfers
+        // the reference to the underlying `local` instance.
+        local_handle(local_handle const&)            = delete;
+        local_handle& operator=(local_handle const&) = delete;
+
+        local_handle(local_handle&& h);
+        local_handle& operator=(local_handle&& h);
+
         // local_handle::pin()
         auto pin() const -> guard;
 
+        // local_handle::quiescent()
+        // Reports a quiescent state; for handles from register_qsbr().
+        auto quiescent() const -> void;
+
+        // local_handle::offline()
+        // Marks a QSBR participant offline, e.g. before it blocks.
+        auto offline() const -> void;
+
+        // local_handle::online()
+        // Marks an offline QSBR participant online again.
+        auto online() const -> void;
+
         // local_handle::is_pinned()
         auto is_pinned() const -> bool;
 
         // local_handle::collector()
         auto get_collector() const -> collector const&;
+
+        // local_handle::get_local()
+        // Returns the `local` instance to which this handle refers.
+        //
+        // This is used by the default (thread-local) API to cache
+        // the participant so that pinning is a single TLS load.
+        auto get_local() const noexcept -> local*;
     };
 }
 
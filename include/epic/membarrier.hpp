@@ -0,0 +1,49 @@
+// membarrier.hpp
+
+#ifndef EPIC_MEMBARRIER_H
+#define EPIC_MEMBARRIER_H
+
+#include <atomic>
+
+namespace epic
+{
+    // epic::fence_mode
+    //
+    // The strategy used to order the publication of a participant's
+    // local epoch against the scan performed by global::try_advance().
+    enum class fence_mode
+    {
+        // Outermost pins publish the local epoch with a sequentially
+        // consistent store (an `xchg` or `mfence` on x86-64).
+        symmetric,
+
+        // Outermost pins publish the local epoch with a plain store and
+        // a compiler fence; global::try_advance() issues the heavy fence
+        // on behalf of all threads via membarrier(). This is the
+        // userspace-RCU "memb" flavor. Falls back to `symmetric` when
+        // membarrier() is unavailable.
+        asymmetric
+    };
+
+    // membarrier_register()
+    // Registers the process for private expedited membarrier().
+    //
+    // Returns `true` if membarrier_heavy() may be used.
+    auto membarrier_register() -> bool;
+
+    // membarrier_heavy()
+    // Issues a memory barrier on every CPU running a thread of this process.
+    //
+    // Pairs with membarrier_light(); returns `false` on failure.
+    auto membarrier_heavy() -> bool;
+
+    // membarrier_light()
+    // The read-side half of an asymmetric fence: prevents only
+    // compiler reordering, the CPU fence is issued by membarrier_heavy().
+    inline auto membarrier_light() -> void
+    {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+}
+
+#endif // EPIC_MEMBARRIER_H
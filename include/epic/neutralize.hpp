@@ -0,0 +1,193 @@
+// neutralize.hpp
+
+#ifndef EPIC_NEUTRALIZE_H
+#define EPIC_NEUTRALIZE_H
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <csetjmp>
+#include <cstdint>
+#include <utility>
+#include <pthread.h>
+#include <type_traits>
+
+#include "guard.hpp"
+#include "type_alias.hpp"
+#include "local_handle.hpp"
+
+namespace epic
+{
+    class local;
+    class registry;
+    struct participant_slot;
+
+    // epic::neutralizer
+    //
+    // The opt-in robust mode of a collector, after DEBRA+ and NBR.
+    //
+    // When global::try_advance() finds a participant pinned in a stale
+    // epoch for longer than the configured patience, and that participant
+    // is inside a restartable read phase (see epic::restartable()), the
+    // collector sends its thread a POSIX real-time signal. The handler
+    // unpins the participant and jumps back to the start of the read
+    // phase, which then repins in the current epoch and retries; the
+    // epoch is free to advance. Participants outside a restartable read
+    // phase are never signalled.
+    //
+    // The signal and the end of the read phase exclude each other through
+    // the participant's read_phase, so a thread is never signalled after
+    // it has left the read phase (and possibly exited). The handler is
+    // shared by every collector in the process; it only restarts a read
+    // phase whose own collector sent the signal.
+    class neutralizer
+    {
+        // The signal number; zero when neutralization is disabled.
+        std::atomic<int> signo;
+
+        // How long the epoch must be stuck before signalling (nanoseconds).
+        std::atomic<std::int64_t> patience;
+
+        // The time of the last advance of the global epoch (steady clock,
+        // nanoseconds); only maintained while neutralization is enabled.
+        std::atomic<std::int64_t> last_advance;
+
+    public:
+        neutralizer();
+
+        neutralizer(neutralizer const&)            = delete;
+        neutralizer& operator=(neutralizer const&) = delete;
+
+        // neutralizer::enable()
+        // Installs the process-wide handler for `signal` (SIGRTMIN if zero)
+        // and enables neutralization after `after`. Returns `false` if the
+        // handler could not be installed.
+        auto enable(std::chrono::nanoseconds after, int signal = 0) -> bool;
+
+        // neutralizer::disable()
+        auto disable() noexcept -> void;
+
+        // neutralizer::is_enabled()
+        auto is_enabled() const noexcept -> bool;
+
+        // neutralizer::on_advance()
+        // Called by global::try_advance() after advancing the epoch.
+        auto on_advance() noexcept -> void;
+
+        // neutralizer::on_stall()
+        // Called by global::try_advance() for every participant that holds
+        // back the epoch; `slot` is signalled if it is in a restartable read
+        // phase and the epoch has been stuck long enough. Returns `true` if
+        // a signal was sent.
+        auto on_stall(registry& participants, usize_t slot) -> bool;
+    };
+
+    // epic::checkpoint
+    //
+    // The restart point of a restartable read phase; used by
+    // epic::restartable(), which should be preferred.
+    //
+    // A checkpoint is neutralizable only if the collector is in robust
+    // mode and the read phase holds the outermost guard of its participant;
+    // nested read phases run to completion like ordinary critical sections.
+    class checkpoint
+    {
+    public:
+        // The context restored by the signal handler.
+        sigjmp_buf env;
+
+    private:
+        // The participant running the read phase.
+        local* owner;
+
+        // The participant's registry slot.
+        participant_slot* slot;
+
+        // The enclosing checkpoint on this thread, if any.
+        checkpoint* prev;
+
+        // Can the signal handler currently restart the read phase?
+        volatile std::sig_atomic_t armed;
+
+        // Was the read phase neutralizable on entry?
+        bool const neutralizable;
+
+        // The number of times the read phase was restarted.
+        usize_t restarts;
+
+        friend auto neutralize_current(int) -> void;
+
+    public:
+        explicit checkpoint(local_handle const& h);
+
+        // The destructor disarms the checkpoint (e.g. if the
+        // read phase exits by throwing an exception).
+        ~checkpoint();
+
+        checkpoint(checkpoint const&)            = delete;
+        checkpoint& operator=(checkpoint const&) = delete;
+
+        // checkpoint::arm()
+        // Enter the read phase: from here on, the thread may be restarted.
+        auto arm() -> void;
+
+        // checkpoint::disarm()
+        // Leave the read phase: the thread may no longer be restarted.
+        auto disarm() noexcept -> void;
+
+        // checkpoint::resume()
+        // Called after a restart to repin the participant, which
+        // the signal handler unpinned, in the current epoch.
+        auto resume() -> void;
+
+        // checkpoint::is_neutralizable()
+        auto is_neutralizable() const noexcept -> bool;
+
+        // checkpoint::restart_count()
+        auto restart_count() const noexcept -> usize_t;
+    };
+
+    // epic::restartable()
+    // Runs the read phase `f` under a guard of the participant `h`,
+    // restarting it from the top if the collector neutralizes it.
+    //
+    // `f` is invoked as `f(guard&)` and may be invoked several times. Since
+    // a restart unwinds the read phase with siglongjmp(), it must only read
+    // shared memory through the guard: it must not allocate, take locks,
+    // defer functions, or construct objects with non-trivial destructors,
+    // and its result must be trivially destructible. Pointers loaded in
+    // the read phase remain protected after it returns, until `g` is
+    // dropped at the end of this call; reserve (e.g. copy or take a
+    // reference count on) whatever the following write phase needs.
+    template <typename F>
+    auto restartable(local_handle const& h, F&& f)
+    {
+        using result_t = std::invoke_result_t<F&, guard&>;
+        static_assert(std::is_void_v<result_t> || std::is_trivially_destructible_v<result_t>,
+            "the result of a restartable read phase must be trivially destructible");
+
+        auto g  = h.pin();
+        auto cp = checkpoint{h};
+
+        if (0 != sigsetjmp(cp.env, 1))
+        {
+            // Neutralized; the participant was unpinned by the handler.
+            cp.resume();
+        }
+
+        cp.arm();
+        if constexpr (std::is_void_v<result_t>)
+        {
+            f(g);
+            cp.disarm();
+        }
+        else
+        {
+            result_t result = f(g);
+            cp.disarm();
+            return result;
+        }
+    }
+}
+
+#endif // EPIC_NEUTRALIZE_H
@@ -116,7 +116,9 @@ namespace epic
         // exclusive ownership of the pointee.
         static auto into_usize(owned<T>&& o) -> size_t
         {
-            return o.data;
+            auto const data = o.data;
+            o.data = 0;
+            return data;
         }
 
         // owned::from_usize()
@@ -6,6 +6,8 @@
 #include <memory>
 #include <cstddef>
 
+#include "era.hpp"
+
 namespace epic
 {
     template<typename T>
@@ -23,10 +25,14 @@ namespace epic
 
         // pointable::init()
         // Initializes a new pointable via perfect forwarding.
+        //
+        // Objects of types derived from epic::era_stamped are
+        // stamped with their birth era (see ibr_collector).
         template<typename... Args>
         static auto init(Args&&... args) -> size_t
         {
             auto box = std::make_unique<T>(std::forward<Args>(args)...);
+            stamp_birth_era(box.get());
             return reinterpret_cast<size_t>(box.release());
         }
 
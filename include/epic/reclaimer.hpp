@@ -0,0 +1,81 @@
+// reclaimer.hpp
+
+#ifndef EPIC_RECLAIMER_H
+#define EPIC_RECLAIMER_H
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+
+namespace epic
+{
+    struct global;
+
+    // epic::reclaimer
+    //
+    // A dedicated background thread that periodically advances
+    // the global epoch and drains the global queue of deferred
+    // functions on behalf of a collector instance.
+    //
+    // When a reclaimer is running, participants registered as
+    // reader-only never pay for collection on their pin path.
+    class reclaimer
+    {
+        // The thread that performs reclamation, if running.
+        std::thread worker;
+
+        // Serializes start / stop; held by stop() until the worker
+        // has been joined, so that start() never replaces a joinable thread.
+        std::mutex control;
+
+        // Guards `running` and the wait on `wake`.
+        std::mutex lock;
+
+        // Signalled to wake the worker early (stop requests).
+        std::condition_variable wake;
+
+        // Is the worker thread running?
+        // Written under `lock`, read without it while draining.
+        std::atomic_bool running;
+
+        // The interval between reclamation passes.
+        std::chrono::milliseconds interval;
+
+    public:
+        // The default interval between reclamation passes.
+        constexpr static std::chrono::milliseconds const DEFAULT_INTERVAL{10};
+
+        reclaimer();
+
+        // The destructor stops the worker thread, if it is running.
+        ~reclaimer();
+
+        reclaimer(reclaimer const&)            = delete;
+        reclaimer& operator=(reclaimer const&) = delete;
+
+        reclaimer(reclaimer&&)            = delete;
+        reclaimer& operator=(reclaimer&&) = delete;
+
+        // reclaimer::start()
+        // Start the worker thread, which collects garbage from `g`
+        // every `interval`. Returns `false` if already running.
+        auto start(global& g, std::chrono::milliseconds interval) -> bool;
+
+        // reclaimer::stop()
+        // Stop the worker thread and wait for it to exit.
+        // Returns `false` if the worker was not running.
+        auto stop() -> bool;
+
+        // reclaimer::is_running()
+        auto is_running() const -> bool;
+
+    private:
+        // reclaimer::run()
+        // The worker thread's main loop.
+        auto run(global& g) -> void;
+    };
+}
+
+#endif // EPIC_RECLAIMER_H
@@ -0,0 +1,246 @@
+// registry.hpp
+
+#ifndef EPIC_REGISTRY_H
+#define EPIC_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <pthread.h>
+
+#include "epoch.hpp"
+#include "stats.hpp"
+#include "type_alias.hpp"
+#include "cache_padded.hpp"
+
+namespace epic
+{
+    // epic::read_phase
+    //
+    // The state of a participant's restartable read phase (see
+    // epic::neutralizer). It orders the neutralizing signal against the
+    // end of the read phase, and so against the exit of its thread.
+    enum class read_phase : int
+    {
+        // Not in a restartable read phase; must not be signalled.
+        idle,
+
+        // In a restartable read phase.
+        armed,
+
+        // The collector is sending the signal; until it has been sent,
+        // the thread cannot leave the read phase (and so cannot exit).
+        signalling,
+
+        // The signal was sent by the collector that owns this slot.
+        signalled
+    };
+
+    // epic::participant_slot
+    //
+    // The state of a single participant that other threads read
+    // when attempting to advance the global epoch.
+    struct participant_slot
+    {
+        // The local epoch of the participant that owns this slot.
+        atomic_epoch local_epoch;
+
+        // The head of the participant's list of batches under
+        // scheme::hyaline; see hyaline_domain.
+        atomic_usize_t batches;
+
+        // The thread that registered the participant; for diagnostics.
+        std::atomic<std::thread::id> owner;
+
+        // The state of the participant's restartable read phase.
+        std::atomic<read_phase> phase;
+
+        // The thread running the restartable read phase; the target
+        // of the neutralizing signal. Valid unless the phase is idle.
+        std::atomic<pthread_t> native;
+
+        // The statistics of the participant; empty unless compiled in.
+        participant_counters counters;
+
+        participant_slot();
+    };
+
+    // epic::straggler
+    //
+    // A participant pinned in a stale epoch, as observed by
+    // registry::for_each_straggler().
+    struct straggler
+    {
+        // The participant's slot; registry::NONE if there is no straggler.
+        usize_t slot;
+
+        // The (pinned) local epoch read from the slot.
+        epoch local_epoch;
+
+        // The owner read from the slot, after the local epoch.
+        std::thread::id owner;
+    };
+
+    // epic::registry
+    //
+    // A contiguous, growable array of participant slots.
+    //
+    // Participants acquire a slot on registration and release it when
+    // they are finalized; released slots are reused. The array grows in
+    // fixed-size chunks that are never moved or freed while the registry
+    // is alive, so it can be scanned concurrently with registration.
+    //
+    // Each slot is padded to a cache line: a participant writes its slot
+    // on every outermost pin, and packing slots densely would make pinning
+    // threads contend on shared lines. The scan instead walks the occupied
+    // slots of each chunk linearly, prefetching them up front.
+    class registry
+    {
+    public:
+        // The number of slots in each chunk (one bit of occupancy each).
+        constexpr static usize_t const SLOTS_PER_CHUNK = 64;
+
+        // The maximum number of chunks, bounding the number of participants.
+        constexpr static usize_t const MAX_CHUNKS = 256;
+
+        // The slot of the straggler returned by registry::find_straggler()
+        // if there is none.
+        constexpr static usize_t const NONE = USIZE_MAX;
+
+    private:
+        struct chunk
+        {
+            // Bitmap of the occupied slots in this chunk.
+            std::atomic<std::uint64_t> occupied;
+
+            // The slots themselves.
+            std::array<cache_padded<participant_slot>, SLOTS_PER_CHUNK> slots;
+
+            chunk();
+        };
+
+        // The chunks allocated so far; the first `chunk_count` are non-null.
+        std::array<std::atomic<chunk*>, MAX_CHUNKS> chunks;
+
+        // The number of chunks allocated.
+        atomic_usize_t chunk_count;
+
+    public:
+        registry();
+
+        ~registry();
+
+        registry(registry const&)            = delete;
+        registry& operator=(registry const&) = delete;
+
+        // registry::acquire()
+        // Acquires an unoccupied slot and returns its index, growing the
+        // registry if necessary. Throws std::runtime_error if exhausted.
+        auto acquire() -> usize_t;
+
+        // registry::release()
+        // Releases the slot at `index` for reuse by another participant.
+        //
+        // The slot's local epoch must be unpinned.
+        auto release(usize_t index) -> void;
+
+        // registry::at()
+        // Returns a reference to the slot at `index`.
+        auto at(usize_t index) -> participant_slot&;
+
+        // registry::find_straggler()
+        // Returns a participant pinned in an epoch other than `e`, or
+        // one with slot registry::NONE if every pinned participant is
+        // pinned in `e`.
+        auto find_straggler(epoch const& e) const -> straggler;
+
+        // registry::for_each_straggler()
+        // Invokes `f` on every participant pinned in an epoch other than
+        // `e`, in slot order, until `f` returns `false`.
+        template <typename F>
+        auto for_each_straggler(epoch const& e, F&& f) const -> void
+        {
+            auto const count = chunk_count.load(std::memory_order_acquire);
+            for (auto i = 0ul; i < count; ++i)
+            {
+                auto const* c = chunks[i].load(std::memory_order_acquire);
+                auto const bits = c->occupied.load(std::memory_order_acquire);
+
+                // Issue the loads of all occupied slots before inspecting
+                // any of them, so that the cache misses overlap.
+                for (auto b = bits; b != 0; b &= b - 1)
+                {
+                    __builtin_prefetch(&c->slots[__builtin_ctzl(b)], 0);
+                }
+
+                for (auto b = bits; b != 0; b &= b - 1)
+                {
+                    auto const& s = *c->slots[__builtin_ctzl(b)];
+                    auto const le = s.local_epoch.load(std::memory_order_relaxed);
+
+                    // Is the participant pinned in a different epoch?
+                    if (le.is_pinned() && le.unpinned() != e)
+                    {
+                        auto const found = straggler{
+                            i*SLOTS_PER_CHUNK + __builtin_ctzl(b),
+                            le,
+                            s.owner.load(std::memory_order_relaxed)};
+
+                        if (!f(found))
+                        {
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+
+        // registry::all_pinned_in()
+        // Returns `true` if every pinned participant is pinned in epoch `e`.
+        auto all_pinned_in(epoch const& e) const -> bool;
+
+        // registry::for_each_occupied()
+        // Invokes `f` on every occupied slot.
+        template <typename F>
+        auto for_each_occupied(F&& f) -> void
+        {
+            auto const count = chunk_count.load(std::memory_order_acquire);
+            for (auto i = 0ul; i < count; ++i)
+            {
+                auto* c = chunks[i].load(std::memory_order_acquire);
+                auto const bits = c->occupied.load(std::memory_order_acquire);
+                for (auto b = bits; b != 0; b &= b - 1)
+                {
+                    f(*c->slots[__builtin_ctzl(b)]);
+                }
+            }
+        }
+
+        // registry::for_each_slot()
+        // Invokes `f` on every allocated slot, occupied or not.
+        template <typename F>
+        auto for_each_slot(F&& f) -> void
+        {
+            auto const count = chunk_count.load(std::memory_order_acquire);
+            for (auto i = 0ul; i < count; ++i)
+            {
+                auto* c = chunks[i].load(std::memory_order_acquire);
+                for (auto& s : c->slots)
+                {
+                    f(*s);
+                }
+            }
+        }
+
+        // registry::capacity()
+        // Returns the number of slots currently allocated.
+        auto capacity() const noexcept -> usize_t;
+
+        // registry::occupied()
+        // Returns the number of slots currently occupied (approximate).
+        auto occupied() const noexcept -> usize_t;
+    };
+}
+
+#endif // EPIC_REGISTRY_H
@@ -19,6 +19,8 @@ namespace epic
         size_t data;
 
     public:
+        using element_type = T;
+
         shared()  = delete;
         ~shared() = default;
 
@@ -0,0 +1,152 @@
+// stats.hpp
+
+#ifndef EPIC_STATS_H
+#define EPIC_STATS_H
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+#include "type_alias.hpp"
+
+namespace epic
+{
+    // Are collector statistics compiled in?
+    //
+    // Statistics are enabled by defining EPIC_STATS (the EPIC_STATS CMake
+    // option). Otherwise every counter is an empty object whose updates
+    // compile to nothing; collector::stats() then reports only the gauges.
+#if defined(EPIC_STATS)
+    constexpr static bool const STATS_ENABLED = true;
+#else
+    constexpr static bool const STATS_ENABLED = false;
+#endif
+
+    // epic::basic_counter
+    //
+    // A monotonic statistics counter.
+    template <bool Enabled>
+    class basic_counter
+    {
+        std::atomic<std::uint64_t> value;
+
+    public:
+        basic_counter() : value{0} {}
+
+        // basic_counter::add()
+        // Increments a counter that is shared between threads.
+        auto add(std::uint64_t n = 1) noexcept -> void
+        {
+            value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        // basic_counter::bump()
+        // Increments a counter that only the calling thread writes;
+        // this is a plain load and store rather than a locked RMW.
+        auto bump(std::uint64_t n = 1) noexcept -> void
+        {
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        // basic_counter::get()
+        auto get() const noexcept -> std::uint64_t
+        {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    template <>
+    class basic_counter<false>
+    {
+    public:
+        auto add(std::uint64_t = 1) noexcept -> void {}
+
+        auto bump(std::uint64_t = 1) noexcept -> void {}
+
+        auto get() const noexcept -> std::uint64_t
+        {
+            return 0;
+        }
+    };
+
+    using counter = basic_counter<STATS_ENABLED>;
+
+    // epic::participant_counters
+    //
+    // The counters of a single participant, written only by its owner.
+    // They live in the participant's registry slot, next to its local
+    // epoch, and are summed by collector::stats().
+    //
+    // The counters are never reset: when a participant is finalized they
+    // stay in its slot, and the next participant to acquire the slot keeps
+    // counting from there. The sum over all slots therefore only grows.
+    struct participant_counters
+    {
+        // Calls to local::pin(), including nested pins.
+        counter pins;
+
+        // Pins that actually pinned the participant (guard count 0 -> 1).
+        counter outermost_pins;
+
+        // Deferred functions retired by the participant.
+        counter deferreds;
+    };
+
+    // epic::collector_counters
+    //
+    // The counters shared by all participants of a collector.
+    struct collector_counters
+    {
+        // Calls to global::try_advance().
+        counter advance_attempts;
+
+        // Calls to global::try_advance() that advanced the epoch.
+        counter advances;
+
+        // Deferred functions executed.
+        counter deferreds_executed;
+    };
+
+    // epic::collector_stats
+    //
+    // A snapshot of a collector's statistics, returned by collector::stats().
+    //
+    // Each counter is read once; since counters only grow, the snapshot
+    // is consistent up to the increments made while it was being taken,
+    // and successive snapshots never go backwards. Bags are counted as
+    // pushed before they can be collected, and the collected counts are
+    // read first, so bags_collected never exceeds bags_pushed.
+    // The counters are zero unless statistics are compiled in.
+    struct collector_stats
+    {
+        // Are the counters below maintained (see STATS_ENABLED)?
+        bool enabled;
+
+        // Counters.
+        std::uint64_t pins;
+        std::uint64_t outermost_pins;
+        std::uint64_t advance_attempts;
+        std::uint64_t advances;
+        std::uint64_t bags_pushed;
+        std::uint64_t bags_collected;
+        std::uint64_t deferreds_retired;
+        std::uint64_t deferreds_executed;
+
+        // Gauges.
+        std::uint64_t pending_bags;
+        std::uint64_t global_epoch;
+        std::uint64_t participants;
+        std::uint64_t unreclaimed_bytes;
+
+        // collector_stats::to_json()
+        // Renders the snapshot as a single-line JSON object.
+        auto to_json() const -> std::string;
+
+        // collector_stats::to_prometheus()
+        // Renders the snapshot in the Prometheus text exposition format,
+        // naming each metric `<prefix>_<name>`.
+        auto to_prometheus(std::string const& prefix = "epic") const -> std::string;
+    };
+}
+
+#endif // EPIC_STATS_H
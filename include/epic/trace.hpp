@@ -0,0 +1,220 @@
+// trace.hpp
+
+#ifndef EPIC_TRACE_H
+#define EPIC_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "type_alias.hpp"
+
+namespace epic
+{
+    // Is event tracing compiled in?
+    //
+    // Tracing is enabled by defining EPIC_TRACE (the EPIC_TRACE CMake
+    // option). Otherwise trace_event() and trace_clock() are empty inline
+    // functions, and no ring buffers are ever allocated.
+#if defined(EPIC_TRACE)
+    constexpr static bool const TRACE_ENABLED = true;
+#else
+    constexpr static bool const TRACE_ENABLED = false;
+#endif
+
+    // epic::trace_kind
+    //
+    // The events recorded by the library.
+    enum class trace_kind : std::uint8_t
+    {
+        // A participant became pinned; the argument is the epoch.
+        pin,
+        // A participant became unpinned.
+        unpin,
+        // The global epoch was advanced; the argument is the new epoch.
+        advance,
+        // A bag was sealed; the argument is the number of deferreds.
+        seal,
+        // A bag was executed; the argument is the number of deferreds.
+        collect
+    };
+
+    // epic::trace_record
+    //
+    // A single event, as copied out of a ring buffer.
+    struct trace_record
+    {
+        // The timestamp of the event, in ticks of trace_clock().
+        std::uint64_t timestamp;
+
+        // The duration of the event in ticks, or 0 if it is instant.
+        std::uint64_t duration;
+
+        // The event-specific argument (see trace_kind).
+        std::uint64_t arg;
+
+        trace_kind kind;
+    };
+
+    // epic::trace_ring
+    //
+    // A fixed-size ring buffer of the events of a single thread.
+    //
+    // Only the owning thread writes the ring, so recording is a handful of
+    // plain stores. Once full, the ring overwrites its oldest events. Each
+    // entry carries a sequence number (a per-entry seqlock) so that a
+    // concurrent reader detects and skips entries being overwritten.
+    class trace_ring
+    {
+    public:
+        // The number of events in each ring; a power of two.
+        constexpr static usize_t const CAPACITY = 1ul << 14;
+
+    private:
+        // The bits of an entry's word that hold the argument.
+        constexpr static std::uint64_t const ARG_MASK = (1ul << 56) - 1;
+
+        struct entry
+        {
+            // 2*index + 2 once the event at `index` is complete,
+            // odd while it is being written.
+            std::atomic<std::uint64_t> seq;
+            std::atomic<std::uint64_t> timestamp;
+            std::atomic<std::uint64_t> duration;
+            // The kind in the top byte, the argument below it.
+            std::atomic<std::uint64_t> word;
+        };
+
+        // The number of events ever recorded; written only by the owner.
+        std::atomic<std::uint64_t> head;
+
+        // Events before this index were discarded by clear_trace().
+        std::atomic<std::uint64_t> cleared;
+
+        // Has the owning thread exited?
+        std::atomic_bool detached;
+
+        // The OS identifier of the owning thread.
+        std::uint64_t const tid;
+
+        std::vector<entry> entries;
+
+    public:
+        explicit trace_ring(std::uint64_t tid_);
+
+        trace_ring(trace_ring const&)            = delete;
+        trace_ring& operator=(trace_ring const&) = delete;
+
+        // trace_ring::current()
+        // Returns the ring of the calling thread, creating it on first use.
+        // Returns nullptr if the ring cannot be allocated, or once the
+        // thread's thread-local storage has been torn down; the event is
+        // then dropped.
+        static auto current() noexcept -> trace_ring*;
+
+        // trace_ring::record()
+        // Appends an event; must be called by the owning thread.
+        auto record(trace_kind kind, std::uint64_t timestamp,
+            std::uint64_t duration, std::uint64_t arg) noexcept -> void
+        {
+            auto const index = head.load(std::memory_order_relaxed);
+            auto& e = entries[index & (CAPACITY - 1)];
+
+            e.seq.store(2*index + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            e.timestamp.store(timestamp, std::memory_order_relaxed);
+            e.duration.store(duration, std::memory_order_relaxed);
+            e.word.store((static_cast<std::uint64_t>(kind) << 56) | (arg & ARG_MASK),
+                std::memory_order_relaxed);
+
+            e.seq.store(2*index + 2, std::memory_order_release);
+            head.store(index + 1, std::memory_order_release);
+        }
+
+        // trace_ring::snapshot()
+        // Appends the retained events to `out`, oldest first.
+        // Safe to call concurrently with record().
+        auto snapshot(std::vector<trace_record>& out) const -> void;
+
+        // trace_ring::clear()
+        // Discards the events recorded so far.
+        auto clear() noexcept -> void;
+
+        // trace_ring::detach()
+        // Marks the ring as orphaned by its exited owner.
+        auto detach() noexcept -> void;
+
+        // trace_ring::is_detached()
+        auto is_detached() const noexcept -> bool;
+
+        // trace_ring::get_tid()
+        auto get_tid() const noexcept -> std::uint64_t;
+    };
+
+    // trace_clock()
+    // Returns the current time in ticks: the timestamp counter on x86-64,
+    // nanoseconds of the steady clock elsewhere. Returns 0 if tracing is
+    // not compiled in, so a caller's start time costs nothing.
+    inline auto trace_clock() noexcept -> std::uint64_t
+    {
+        if constexpr (TRACE_ENABLED)
+        {
+#if defined(__x86_64__)
+            return __builtin_ia32_rdtsc();
+#else
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    // trace_event()
+    // Records an instant event of `kind` in the calling thread's ring.
+    inline auto trace_event(trace_kind kind, std::uint64_t arg = 0) noexcept -> void
+    {
+        if constexpr (TRACE_ENABLED)
+        {
+            if (auto* ring = trace_ring::current(); nullptr != ring)
+            {
+                ring->record(kind, trace_clock(), 0, arg);
+            }
+        }
+    }
+
+    // trace_span()
+    // Records an event of `kind` that began at `start` (from trace_clock())
+    // and ends now, in the calling thread's ring.
+    inline auto trace_span(trace_kind kind, std::uint64_t start, std::uint64_t arg = 0) noexcept -> void
+    {
+        if constexpr (TRACE_ENABLED)
+        {
+            if (auto* ring = trace_ring::current(); nullptr != ring)
+            {
+                ring->record(kind, start, trace_clock() - start, arg);
+            }
+        }
+    }
+
+    // dump_trace()
+    // Merges the rings of all threads into a JSON document in the Chrome
+    // trace_event format, loadable by Perfetto and chrome://tracing.
+    //
+    // Pins appear as "pinned" slices, collections as "collect" slices with
+    // their duration, and advances and seals as instant events. The rings
+    // are not cleared. If tracing is not compiled in the trace is empty.
+    auto dump_trace() -> std::string;
+
+    // clear_trace()
+    // Discards all recorded events, and frees the rings of exited threads.
+    auto clear_trace() -> void;
+}
+
+#endif // EPIC_TRACE_H
@@ -0,0 +1,117 @@
+// watchdog.hpp
+
+#ifndef EPIC_WATCHDOG_H
+#define EPIC_WATCHDOG_H
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <functional>
+
+#include "epoch.hpp"
+#include "type_alias.hpp"
+
+namespace epic
+{
+    class registry;
+    struct straggler;
+
+    // epic::stall_report
+    //
+    // Describes a participant that is holding back the global epoch.
+    struct stall_report
+    {
+        // The thread that registered the stalled participant.
+        std::thread::id thread;
+
+        // The stalled participant's slot in the registry.
+        usize_t slot;
+
+        // The epoch in which the participant is pinned.
+        epoch pinned_epoch;
+
+        // The current global epoch.
+        epoch global_epoch;
+
+        // The time since the global epoch last advanced. The participant
+        // has been pinned for at least this long: it was pinned before
+        // the last advance and has not been unpinned since.
+        std::chrono::nanoseconds stalled_for;
+    };
+
+    // The callback invoked by the watchdog.
+    //
+    // It runs on whichever thread observed the stall in global::try_advance()
+    // (possibly a pinned participant, or the background reclaimer), so it
+    // should be quick and must not pin the same collector.
+    using stall_callback = std::function<void(stall_report const&)>;
+
+    // epic::watchdog
+    //
+    // Detects participants that keep the global epoch from advancing.
+    //
+    // The watchdog piggybacks on global::try_advance(): a successful
+    // advance records the time, and a scan that finds a participant
+    // pinned in an old epoch checks how long ago that was. Pinning is
+    // not instrumented at all. The callback fires at most once per
+    // stalled global epoch, when the stall first exceeds the threshold.
+    class watchdog
+    {
+        // The stall duration that triggers the callback, in nanoseconds;
+        // zero when the watchdog is disarmed.
+        std::atomic<std::int64_t> threshold;
+
+        // The time of the last advance of the global epoch (steady clock,
+        // nanoseconds); only maintained while the watchdog is armed.
+        std::atomic<std::int64_t> last_advance;
+
+        // The global epoch for which the callback last fired.
+        atomic_epoch reported;
+
+        // Serializes arming and invocations of the callback.
+        std::mutex lock;
+
+        // The user callback.
+        stall_callback callback;
+
+    public:
+        watchdog();
+
+        watchdog(watchdog const&)            = delete;
+        watchdog& operator=(watchdog const&) = delete;
+
+        // watchdog::arm()
+        // Invoke `cb` when the global epoch is stuck for `after`.
+        auto arm(std::chrono::nanoseconds after, stall_callback cb) -> void;
+
+        // watchdog::disarm()
+        auto disarm() -> void;
+
+        // watchdog::is_armed()
+        auto is_armed() const noexcept -> bool;
+
+        // watchdog::on_advance()
+        // Called by global::try_advance() after advancing the epoch.
+        auto on_advance() noexcept -> void
+        {
+            if (is_armed())
+            {
+                last_advance.store(now(), std::memory_order_relaxed);
+            }
+        }
+
+        // watchdog::on_stall()
+        // Called by global::try_advance() when its scan found participant
+        // `s` pinned in an epoch other than `global_epoch`. The report
+        // describes the participant as the scan observed it.
+        auto on_stall(registry& participants, straggler const& s, epoch const& global_epoch) -> void;
+
+        // watchdog::now()
+        // Returns the steady clock time in nanoseconds.
+        static auto now() noexcept -> std::int64_t;
+    };
+}
+
+#endif // EPIC_WATCHDOG_H
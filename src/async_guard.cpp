@@ -0,0 +1,67 @@
+// async_guard.cpp
+
+#include <epic/async_guard.hpp>
+
+#include <cassert>
+
+namespace epic
+{
+    async_guard::async_guard(handle_source source_)
+        : source{source_}
+        , pinned{source_().pin()}
+        , suspensions{0}
+    {}
+
+    async_guard::async_guard(async_guard&& g)
+        : source{g.source}
+        , pinned{std::move(g.pinned)}
+        , suspensions{g.suspensions}
+    {}
+
+    async_guard& async_guard::operator=(async_guard&& g)
+    {
+        if (&g != this)
+        {
+            source      = g.source;
+            pinned      = std::move(g.pinned);
+            suspensions = g.suspensions;
+        }
+
+        return *this;
+    }
+
+    auto async_guard::suspend() -> void
+    {
+        assert(!is_suspended());
+
+        pinned = guard{};
+        ++suspensions;
+    }
+
+    auto async_guard::resume() -> void
+    {
+        assert(is_suspended());
+        pinned = source().pin();
+    }
+
+    auto async_guard::is_suspended() const noexcept -> bool
+    {
+        return pinned.is_dummy();
+    }
+
+    auto async_guard::generation() const noexcept -> usize_t
+    {
+        return suspensions;
+    }
+
+    auto async_guard::get() -> guard&
+    {
+        assert(!is_suspended());
+        return pinned;
+    }
+
+    auto async_guard::flush() -> void
+    {
+        get().flush();
+    }
+}
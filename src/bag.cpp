@@ -3,31 +3,24 @@
 #include <epic/bag.hpp>
 
 #include <cassert>
+#include <algorithm>
+#include <stdexcept>
 
 namespace epic
 {
-    // The no-op function used to initialize a new bag.
-    static auto no_op() -> void {}
-
+    // Default-constructed deferred functions are no-ops that
+    // hold no captures, so initializing a bag is just a fill.
     bag::bag() 
     : sealed{false}
     , count{0}
+    , byte_count{0}
     , sealed_epoch{}
-    , deferreds 
-    {
-        deferred{no_op},
-        deferred{no_op},
-        deferred{no_op},
-        deferred{no_op}
-    } {}
+    , deferreds{} {}
 
     bag::~bag()
     {
         // call all the deferred functions in bag on drop
-        for (auto& d : deferreds)
-        {
-            d.call();
-        }
+        reset();
     }
 
     // bag::is_empty()
@@ -36,6 +29,18 @@ namespace epic
         return 0 == count;
     }
 
+    // bag::size()
+    auto bag::size() const noexcept -> size_t
+    {
+        return count;
+    }
+
+    // bag::is_full()
+    auto bag::is_full() const noexcept -> bool
+    {
+        return MAX_OBJECTS == count;
+    }
+
     // bag::is_expired()
     // Determines if it is safe to collect the given bag
     // with respect to the current global epoch.
@@ -46,8 +51,14 @@ namespace epic
         return e.wrapping_sub(sealed_epoch) >= 2;
     }
 
+    // bag::size_in_bytes()
+    auto bag::size_in_bytes() const noexcept -> size_t
+    {
+        return byte_count;
+    }
+
     // bag::try_push()
-    auto bag::try_push(deferred&& def) -> std::optional<deferred>
+    auto bag::try_push(deferred&& def, size_t const bytes) -> std::optional<deferred>
     {
         if (sealed)
         {
@@ -57,6 +68,7 @@ namespace epic
         if (this->count < MAX_OBJECTS)
         {
             deferreds[count++] = std::move(def);
+            byte_count += bytes;
             return std::nullopt;
         }
         else
@@ -65,6 +77,25 @@ namespace epic
         }
     }
 
+    // bag::push_many()
+    auto bag::push_many(deferred* first, size_t const n, size_t const bytes) -> size_t
+    {
+        if (sealed)
+        {
+            throw std::runtime_error{"Attempt to push into a sealed bag"};
+        }
+
+        auto const moved = std::min(n, MAX_OBJECTS - count);
+        for (auto i = 0ul; i < moved; ++i)
+        {
+            deferreds[count++] = std::move(first[i]);
+        }
+
+        byte_count += bytes_share(bytes, moved, n);
+
+        return moved;
+    }
+
     // bag::seal()
     // Seals the bag with the given epoch.
     auto bag::seal(epoch const& e) -> void
@@ -73,4 +104,22 @@ namespace epic
         sealed_epoch = e;
         sealed       = true;
     }
+
+    // bag::reset()
+    // Executes all stored deferred functions and returns
+    // the bag to its empty, unsealed state for reuse.
+    auto bag::reset() -> void
+    {
+        // slots beyond `count` were never filled; calling a
+        // deferred function leaves a no-op in its slot
+        for (auto i = 0ul; i < count; ++i)
+        {
+            deferreds[i].call();
+        }
+
+        count        = 0;
+        byte_count   = 0;
+        sealed       = false;
+        sealed_epoch = epoch{};
+    }
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+// bag_pool.cpp
+
+#include <epic/bag_pool.hpp>
+
+#include <cassert>
+
+namespace epic
+{
+    bag_pool::bag_pool(usize_t const capacity_)
+        : bags{}
+        , capacity{capacity_}
+    {
+        // Reserve up front so that recycling never reallocates.
+        bags.reserve(capacity);
+    }
+
+    auto bag_pool::take() -> std::unique_ptr<bag>
+    {
+        if (bags.empty())
+        {
+            return nullptr;
+        }
+
+        auto b = std::move(bags.back());
+        bags.pop_back();
+
+        return b;
+    }
+
+    auto bag_pool::try_put(std::unique_ptr<bag>&& b) -> std::unique_ptr<bag>
+    {
+        assert(b->is_empty());
+
+        if (is_full())
+        {
+            return std::move(b);
+        }
+
+        bags.push_back(std::move(b));
+        return nullptr;
+    }
+
+    auto bag_pool::size() const noexcept -> usize_t
+    {
+        return bags.size();
+    }
+
+    auto bag_pool::is_full() const noexcept -> bool
+    {
+        return bags.size() >= capacity;
+    }
+
+    auto bag_pool::clear() -> void
+    {
+        bags.clear();
+    }
+}
@@ -11,6 +11,12 @@ namespace epic
     collector::collector() 
         : instance{std::move(std::make_shared<global>())} {}
 
+    collector::collector(fence_mode mode)
+        : instance{std::make_shared<global>(mode)} {}
+
+    collector::collector(scheme s, fence_mode mode)
+        : instance{std::make_shared<global>(mode, s)} {}
+
     collector::collector(collector const& c) 
         : instance{c.instance} {}
 
@@ -39,6 +45,149 @@ namespace epic
         return local::register_handle(*this);
     }
 
+    auto collector::register_reader() -> local_handle
+    {
+        return local::register_handle(*this, true);
+    }
+
+    auto collector::register_qsbr() -> local_handle
+    {
+        return local::register_handle(*this, false, true);
+    }
+
+    auto collector::start_reclaimer(std::chrono::milliseconds interval) -> bool
+    {
+        return instance->background.start(*instance, interval);
+    }
+
+    auto collector::stop_reclaimer() -> bool
+    {
+        return instance->background.stop();
+    }
+
+    auto collector::is_reclaimer_running() const -> bool
+    {
+        return instance->background.is_running();
+    }
+
+    auto collector::start_workers(std::size_t const threads) -> bool
+    {
+        return instance->workers.start(*instance, threads);
+    }
+
+    auto collector::stop_workers() -> bool
+    {
+        return instance->workers.stop();
+    }
+
+    auto collector::worker_count() const -> std::size_t
+    {
+        return instance->workers.thread_count();
+    }
+
+    auto collector::set_stall_watchdog(std::chrono::nanoseconds const threshold, stall_callback callback) -> void
+    {
+        instance->stall_watch.arm(threshold, std::move(callback));
+    }
+
+    auto collector::clear_stall_watchdog() -> void
+    {
+        instance->stall_watch.disarm();
+    }
+
+    auto collector::enable_neutralization(std::chrono::nanoseconds const patience, int const signal) -> bool
+    {
+        return instance->robust.enable(patience, signal);
+    }
+
+    auto collector::disable_neutralization() -> void
+    {
+        instance->robust.disable();
+    }
+
+    auto collector::stats() const -> collector_stats
+    {
+        return instance->stats();
+    }
+
+    auto collector::trim() -> std::size_t
+    {
+        return instance->trim();
+    }
+
+    auto collector::set_byte_threshold(std::size_t const bytes) -> void
+    {
+        instance->byte_threshold.store(bytes, std::memory_order_relaxed);
+    }
+
+    auto collector::get_byte_threshold() const -> std::size_t
+    {
+        return instance->byte_threshold.load(std::memory_order_relaxed);
+    }
+
+    auto collector::unreclaimed_bytes() const -> std::size_t
+    {
+        return instance->unreclaimed();
+    }
+
+    auto collector::set_garbage_cap(std::size_t const bags, backpressure const policy) -> void
+    {
+        instance->policy.store(policy, std::memory_order_relaxed);
+        instance->garbage_cap.store(bags, std::memory_order_relaxed);
+    }
+
+    auto collector::get_garbage_cap() const -> std::size_t
+    {
+        return instance->garbage_cap.load(std::memory_order_relaxed);
+    }
+
+    auto collector::get_backpressure() const -> backpressure
+    {
+        return instance->policy.load(std::memory_order_relaxed);
+    }
+
+    auto collector::get_fence_mode() const -> fence_mode
+    {
+        return instance->get_fence_mode();
+    }
+
+    auto collector::synchronize() -> void
+    {
+        instance->synchronize(false);
+    }
+
+    auto collector::synchronize_expedited() -> void
+    {
+        instance->synchronize(true);
+    }
+
+    auto collector::notify_after_grace_period(std::function<void()> callback) -> void
+    {
+        instance->after_grace_period(deferred::make(std::move(callback)));
+    }
+
+    auto collector::grace_period_fd() -> int
+    {
+        return instance->grace.fd();
+    }
+
+    auto collector::request_grace_period() -> bool
+    {
+        auto& grace = instance->grace;
+        if (grace.fd() < 0)
+        {
+            return false;
+        }
+
+        instance->after_grace_period(deferred::make([&grace]() { grace.signal(); }));
+        return true;
+    }
+
+    auto collector::get_scheme() const -> scheme
+    {
+        return instance->get_scheme();
+    }
+
     auto collector::release() -> void
     {
         instance.reset();
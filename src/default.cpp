@@ -0,0 +1,92 @@
+// default.cpp
+
+#include <epic/default.hpp>
+#include <epic/local.hpp>
+
+namespace epic
+{
+    // The current thread's participant in the default collector.
+    //
+    // Both variables are constant-initialized, so reading them
+    // does not go through a thread-local initialization guard.
+    static thread_local local* current_local = nullptr;
+    static thread_local bool   current_exited = false;
+
+    // The thread-local registration in the default collector.
+    //
+    // Registering publishes the participant in `current_local`;
+    // on thread exit the handle is released and the participant
+    // is finalized once it is no longer pinned.
+    struct thread_handle
+    {
+        local_handle handle;
+
+        thread_handle() 
+            : handle{default_collector().register_handle()}
+        {
+            current_local = handle.get_local();
+        }
+
+        ~thread_handle()
+        {
+            current_local  = nullptr;
+            current_exited = true;
+        }
+    };
+
+    static auto current_handle() -> thread_handle&
+    {
+        static thread_local thread_handle h{};
+        return h;
+    }
+
+    auto default_collector() -> collector&
+    {
+        static collector c{};
+        return c;
+    }
+
+    auto default_handle() -> local_handle const&
+    {
+        return current_handle().handle;
+    }
+
+    // pin_slow()
+    // Registers the current thread on its first pin.
+    //
+    // If the thread-local handle has already been destroyed (we are
+    // called from another thread-local destructor) the thread is pinned
+    // via a temporary handle; the participant is finalized on unpin.
+    __attribute__((noinline)) static auto pin_slow() -> guard
+    {
+        if (current_exited)
+        {
+            return default_collector().register_handle().pin();
+        }
+
+        return current_handle().handle.pin();
+    }
+
+    auto pin() -> guard
+    {
+        auto* const l = current_local;
+        if (__builtin_expect(nullptr != l, 1))
+        {
+            return l->pin();
+        }
+
+        return pin_slow();
+    }
+
+    auto is_pinned() -> bool
+    {
+        auto* const l = current_local;
+        if (nullptr != l)
+        {
+            return l->is_pinned();
+        }
+
+        // An unregistered thread cannot be pinned.
+        return false;
+    }
+}
@@ -0,0 +1,122 @@
+// executor.cpp
+
+#include <epic/executor.hpp>
+#include <epic/global.hpp>
+#include <epic/bag.hpp>
+
+namespace epic
+{
+    executor::executor()
+        : workers{}
+        , lock{}
+        , ready{}
+        , work{}
+        , running{false}
+        , control{}
+    {}
+
+    executor::~executor()
+    {
+        stop();
+    }
+
+    auto executor::start(global& g, usize_t const threads) -> bool
+    {
+        std::lock_guard<std::mutex> c{control};
+        if (0 == threads || running)
+        {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            running = true;
+        }
+
+        for (auto i = 0ul; i < threads; ++i)
+        {
+            workers.emplace_back([this, &g](){ run(g); });
+        }
+
+        return true;
+    }
+
+    auto executor::stop() -> bool
+    {
+        std::lock_guard<std::mutex> c{control};
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            if (!running)
+            {
+                return false;
+            }
+
+            running = false;
+        }
+
+        // The workers exit once the remaining work is done.
+        ready.notify_all();
+        for (auto& w : workers)
+        {
+            w.join();
+        }
+
+        workers.clear();
+
+        return true;
+    }
+
+    auto executor::submit(std::unique_ptr<bag>&& b) -> std::unique_ptr<bag>
+    {
+        if (!running.load(std::memory_order_relaxed))
+        {
+            return std::move(b);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            if (!running)
+            {
+                // Stopped concurrently.
+                return std::move(b);
+            }
+
+            work.push_back(std::move(b));
+        }
+
+        ready.notify_one();
+        return nullptr;
+    }
+
+    auto executor::is_running() const -> bool
+    {
+        return running.load(std::memory_order_acquire);
+    }
+
+    auto executor::thread_count() -> usize_t
+    {
+        std::lock_guard<std::mutex> c{control};
+        return workers.size();
+    }
+
+    auto executor::run(global& g) -> void
+    {
+        std::unique_lock<std::mutex> guard{lock};
+        for (;;)
+        {
+            ready.wait(guard, [this](){ return !running || !work.empty(); });
+            if (work.empty())
+            {
+                // Stopped, and nothing is left to execute.
+                return;
+            }
+
+            auto b = std::move(work.front());
+            work.pop_front();
+
+            guard.unlock();
+            g.execute_bag(std::move(b), nullptr);
+            guard.lock();
+        }
+    }
+}
@@ -1,19 +1,108 @@
 // global.cpp
 
 #include <epic/global.hpp>
-#include <epic/local.hpp>
 
+#include <future>
+#include <thread>
 #include <cassert>
+#include <cstddef>
+#include <algorithm>
 
 namespace epic
 {
-    global::global() 
-        : locals{}
-        , deferred_functions{}
+    // Rounds the requested number of shards up to a power of two,
+    // clamped to the range [1, global::MAX_SHARDS].
+    static auto round_shard_count(usize_t const requested) -> usize_t
+    {
+        auto count = 1ul;
+        while (count < requested && count < global::MAX_SHARDS)
+        {
+            count <<= 1;
+        }
+
+        return count;
+    }
+
+    // Verify the layout of the global data: the global epoch must not share
+    // a cache line with any field that is written at a different rate.
+    // (offsetof() on a non-standard-layout type is conditionally supported;
+    // GCC and Clang evaluate it as a constant expression.)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+    static_assert(0 == offsetof(global, global_epoch) % CACHE_LINE_SIZE,
+        "the global epoch must start a cache line");
+    static_assert(0 == offsetof(global, nonempty_shards) % CACHE_LINE_SIZE,
+        "shard bookkeeping must start a cache line");
+    static_assert(0 == offsetof(global, free_bags) % CACHE_LINE_SIZE,
+        "the shared free pool must start a cache line");
+    static_assert(0 == offsetof(global, counters) % CACHE_LINE_SIZE,
+        "the shared counters must start a cache line");
+    static_assert(0 == offsetof(global, background) % CACHE_LINE_SIZE,
+        "the reclaimer must start a cache line");
+    static_assert(0 == offsetof(global, stall_watch) % CACHE_LINE_SIZE,
+        "the watchdog must start a cache line");
+    static_assert(offsetof(global, trim_generation) < offsetof(global, global_epoch)
+        && offsetof(global, global_epoch) + CACHE_LINE_SIZE <= offsetof(global, stall_watch),
+        "the global epoch must be alone on its cache line");
+#pragma GCC diagnostic pop
+
+    garbage_shard::garbage_shard()
+        : bags{}
+        , pending{0}
+        , pushed{}
+        , collected{}
+    {}
+
+    global::global()
+        : global{std::thread::hardware_concurrency()}
+    {}
+
+    global::global(fence_mode const mode, scheme const s)
+        : global{std::thread::hardware_concurrency(), mode, s}
+    {}
+
+    global::global(usize_t const shard_count_, fence_mode const mode, scheme const s) 
+        : participants{}
+        , shard_count{round_shard_count(shard_count_)}
+        , asymmetric_fences{fence_mode::asymmetric == mode && membarrier_register()}
+        , hyaline{scheme::hyaline == s ? std::make_unique<hyaline_domain>(*this) : nullptr}
+        , shards{std::make_unique<cache_padded<garbage_shard>[]>(shard_count)}
+        , trim_generation{0}
+        , byte_threshold{DEFAULT_BYTE_THRESHOLD}
+        , garbage_cap{0}
+        , policy{backpressure::block}
         , global_epoch{epoch{}}
+        , stall_watch{}
+        , robust{}
+        , nonempty_shards{0}
+        , next_shard{0}
+        , unreclaimed_bytes{0}
+        , free_bags{}
+        , free_count{0}
+        , background{}
+        , workers{}
+        , grace{}
     {}
 
-    auto global::push_bag(std::unique_ptr<bag>&& b) -> void
+    global::~global()
+    {
+        // The reclaimer may still be recycling bags.
+        background.stop();
+
+        // Destroy the remaining garbage, then wait for the workers
+        // (if any) to finish before the free pool is trimmed.
+        drain();
+        workers.stop();
+
+        trim();
+    }
+
+    auto global::assign_shard() -> usize_t
+    {
+        return next_shard.fetch_add(1, std::memory_order_relaxed) & (shard_count - 1);
+    }
+
+    auto global::push_bag(std::unique_ptr<bag>&& b, usize_t const shard) -> void
     {
         // TODO: atomic fence?
 
@@ -21,67 +110,409 @@ namespace epic
         auto const e = global_epoch.load(std::memory_order_relaxed);
         b->seal(e);
 
-        // Push the bag onto the global queue.
-        deferred_functions.push(b.release());
+        // Count the bag before publishing it so that a concurrent
+        // collector never observes the count drop below zero.
+        auto& s = shard_at(shard);
+        if (0 == s.pending.fetch_add(1, std::memory_order_relaxed))
+        {
+            nonempty_shards.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Push the bag onto the shard's queue.
+        trace_event(trace_kind::seal, b->size());
+        // Count the bag before it can be collected; see global::stats().
+        s.pushed.add();
+        s.bags.push(b.release());
+    }
+
+    auto global::collect(usize_t const home, bag_pool* pool) -> usize_t
+    {
+        return collect(home, collect_steps(pending(home)), pool);
     }
 
-    auto global::collect() -> void
+    auto global::collect(usize_t const home, usize_t const steps, bag_pool* pool) -> usize_t
     {
+        // Nothing to collect; avoid scanning the list of `local`s.
+        if (0 == nonempty_shards.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+
         // Attempt to advance the global epoch. 
         auto e = try_advance();
 
-        auto const steps = global::COLLECT_STEPS;
-        for (auto i = 0; i < steps; ++i)
+        // Drain the home shard first, then steal from the others.
+        auto collected = 0ul;
+        for (auto i = 0ul; i < shard_count && collected < steps; ++i)
+        {
+            auto& s = shard_at(home + i);
+            if (0 == s.pending.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            while (collected < steps)
+            {
+                // Pop a bag from the queue, provided it is expired.
+                std::optional<bag*> popped_bag = s.bags.try_pop_if(
+                    [&e](bag* b) -> bool 
+                    { 
+                        return b->is_expired(e); 
+                    });
+
+                if (!popped_bag.has_value())
+                {
+                    // Shard is empty or the bag is not expired, move on to the next.
+                    break;
+                }
+
+                // Otherwise, we got a valid bag of deferred functions, execute them.
+                if (1 == s.pending.fetch_sub(1, std::memory_order_relaxed))
+                {
+                    nonempty_shards.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                s.collected.add();
+
+                // Hand the bag to the worker pool, or execute it ourselves.
+                auto b = workers.submit(std::unique_ptr<bag>{popped_bag.value()});
+                if (b)
+                {
+                    execute_bag(std::move(b), pool);
+                }
+
+                ++collected;
+            }
+        }
+
+        return collected;
+    }
+
+    auto global::execute_bag(std::unique_ptr<bag>&& b, bag_pool* pool) -> void
+    {
+        auto const bytes = b->size_in_bytes();
+        auto const count = b->size();
+        counters.deferreds_executed.add(count);
+
+        auto const start = trace_clock();
+        b->reset();
+        trace_span(trace_kind::collect, start, count);
+
+        if (0 != bytes)
+        {
+            unreclaimed_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        recycle_bag(std::move(b), pool);
+    }
+
+    auto global::drain() -> void
+    {
+        for (auto i = 0ul; i < shard_count; ++i)
         {
-            // Pop a bag from the queue, provided it is expired.
-            std::optional<bag*> popped_bag = deferred_functions.try_pop_if(
-                [&e](bag* b) -> bool 
-                { 
-                    return b->is_expired(e); 
-                });
+            auto& s = shard_at(i);
+            for (;;)
+            {
+                auto popped = s.bags.try_pop_if([](bag*) -> bool { return true; });
+                if (!popped.has_value())
+                {
+                    break;
+                }
+
+                s.pending.fetch_sub(1, std::memory_order_relaxed);
+
+                auto b = workers.submit(std::unique_ptr<bag>{popped.value()});
+                if (b)
+                {
+                    execute_bag(std::move(b), nullptr);
+                }
+            }
+        }
+
+        nonempty_shards.store(0, std::memory_order_relaxed);
+    }
+
+    auto global::acquire_bag(bag_pool* pool) -> std::unique_ptr<bag>
+    {
+        if (nullptr != pool)
+        {
+            if (auto b = pool->take())
+            {
+                return b;
+            }
+        }
+
+        if (0 != free_count.load(std::memory_order_relaxed))
+        {
+            auto popped = free_bags.try_pop_if([](bag*) -> bool { return true; });
+            if (popped.has_value())
+            {
+                free_count.fetch_sub(1, std::memory_order_relaxed);
+                return std::unique_ptr<bag>{popped.value()};
+            }
+        }
+
+        return std::make_unique<bag>();
+    }
+
+    auto global::recycle_bag(std::unique_ptr<bag>&& b, bag_pool* pool) -> void
+    {
+        if (nullptr != pool)
+        {
+            b = pool->try_put(std::move(b));
+            if (!b)
+            {
+                return;
+            }
+        }
+
+        // Reserve a slot in the shared free pool; if it is full,
+        // drop the reservation and let the bag be freed.
+        if (free_count.fetch_add(1, std::memory_order_relaxed) < MAX_FREE_BAGS)
+        {
+            free_bags.push(b.release());
+        }
+        else
+        {
+            free_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
 
-            if (!popped_bag.has_value())
+    auto global::trim() -> usize_t
+    {
+        trim_generation.fetch_add(1, std::memory_order_relaxed);
+
+        auto freed = 0ul;
+        for (;;)
+        {
+            auto popped = free_bags.try_pop_if([](bag*) -> bool { return true; });
+            if (!popped.has_value())
             {
-                // Queue is empty or the bag is not expired, done collecting for now.
                 break;
             }
 
-            // Otherwise, we got a valid bag of deferred functions, execute them.
-            delete popped_bag.value();
+            free_count.fetch_sub(1, std::memory_order_relaxed);
+            delete popped.value();
+            ++freed;
+        }
+
+        return freed;
+    }
+
+    auto global::account_bytes(usize_t const bytes) noexcept -> bool
+    {
+        auto const before    = unreclaimed_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        auto const threshold = byte_threshold.load(std::memory_order_relaxed);
+        return 0 != threshold && before < threshold && before + bytes >= threshold;
+    }
+
+    auto global::unreclaimed() const noexcept -> usize_t
+    {
+        return unreclaimed_bytes.load(std::memory_order_relaxed);
+    }
+
+    auto global::is_under_pressure() const noexcept -> bool
+    {
+        auto const threshold = byte_threshold.load(std::memory_order_relaxed);
+        return 0 != threshold && unreclaimed() >= threshold;
+    }
+
+    auto global::pending(usize_t const shard) const noexcept -> usize_t
+    {
+        auto const own = shard_at(shard).pending.load(std::memory_order_relaxed);
+        if (0 != own)
+        {
+            return own;
         }
+
+        return (0 != nonempty_shards.load(std::memory_order_relaxed)) ? 1 : 0;
+    }
+
+    auto global::pending() const noexcept -> usize_t
+    {
+        auto total = 0ul;
+        for (auto i = 0ul; i < shard_count; ++i)
+        {
+            total += shard_at(i).pending.load(std::memory_order_relaxed);
+        }
+
+        return total;
+    }
+
+    auto global::collect_steps(usize_t const pending) noexcept -> usize_t
+    {
+        return std::clamp(pending / 4, COLLECT_STEPS, MAX_COLLECT_STEPS);
     }
 
     auto global::try_advance() -> epoch
     {
+        counters.advance_attempts.add();
+
         auto ge = global_epoch.load(std::memory_order_relaxed);
-        // TODO: atomic fence??
 
-        auto const broken = locals.iterate_while(
-            [](lowlock::list_entry* e){ ; },
-            [=](lowlock::list_entry* e) -> bool
+        // Order the loads of local epochs below after every store that
+        // published them. Participants publish with a plain store under
+        // asymmetric fences, so the full barrier is issued on their behalf.
+        if (asymmetric_fences)
+        {
+            if (!membarrier_heavy())
             {
-                // Get a reference to the local for the element.
-                auto& l = local::element_of(*e);
-                // Query the current local epoch.
-                auto local_epoch = l.get_epoch();
-                // Determine if the local is pinned in a different epoch.
-                return local_epoch.is_pinned() 
-                    && local_epoch.unpinned() != ge;
-            });
+                // The plain stores may not be visible yet; do not advance.
+                return ge;
+            }
+        }
+        else
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        // Determine if any participant is pinned in a different epoch. The
+        // first straggler settles that; in robust mode the scan goes on, so
+        // that every neutralizable straggler is signalled, not only one that
+        // happens to come first in slot order but cannot be neutralized.
+        auto const neutralizing = robust.is_enabled();
+        auto first = straggler{registry::NONE, epoch{}, std::thread::id{}};
+        participants.for_each_straggler(ge, [&](straggler const& s)
+        {
+            if (registry::NONE == first.slot)
+            {
+                first = s;
+            }
+
+            if (neutralizing)
+            {
+                robust.on_stall(participants, s.slot);
+            }
+
+            return neutralizing;
+        });
+
+        // Synchronize with the unpinning of the participants scanned above.
+        std::atomic_thread_fence(std::memory_order_acquire);
 
-        // TODO: atomic fence??
+        if (registry::NONE != first.slot)
+        {
+            // A participant is pinned in a previous epoch;
+            // the global epoch cannot be advanced yet.
+            stall_watch.on_stall(participants, first, ge);
+            return ge;
+        }
 
         // All pinned participants are pinned in the current global epoch;
         // therefore it is appropriate the advance the global epoch.
         //
-        // Note that if another thread already advanced the global epoch
-        // in front of us, this store will simply overwrite the global epoch
-        // with the same value (a dead store). This is true because `try_advance()`
-        // was called from a thread that was pinned in `global_epoch`, and 
-        // the global epoch cannot be advanced two steps ahead of it.
-        auto new_epoch = ge.successor();
-        global_epoch.store(new_epoch, std::memory_order_release);
+        // If another thread already advanced the global epoch in front of
+        // us the exchange fails and we return the epoch it installed. A
+        // pinned caller could use a plain store here (the epoch cannot move
+        // two steps ahead of it), but the background reclaimer is not pinned.
+        auto const new_epoch = ge.successor();
+        auto const prev = global_epoch.compare_and_swap(
+            ge, new_epoch, std::memory_order_release);
+
+        if (prev != ge)
+        {
+            return prev;
+        }
 
+        counters.advances.add();
+        trace_event(trace_kind::advance, new_epoch.get() >> 1);
+        stall_watch.on_advance();
+        robust.on_advance();
         return new_epoch;
     }
+
+    auto global::shard_at(usize_t const index) const noexcept -> garbage_shard&
+    {
+        return *shards[index & (shard_count - 1)];
+    }
+
+    auto global::stats() -> collector_stats
+    {
+        auto s = collector_stats{};
+        s.enabled = STATS_ENABLED;
+
+        // The participants' counters. Summing every slot, occupied or not,
+        // includes finalized participants, whose counts stay in their slots.
+        s.pins              = 0;
+        s.outermost_pins    = 0;
+        s.deferreds_retired = 0;
+        participants.for_each_slot([&s](participant_slot& p)
+        {
+            s.pins              += p.counters.pins.get();
+            s.outermost_pins    += p.counters.outermost_pins.get();
+            s.deferreds_retired += p.counters.deferreds.get();
+        });
+
+        s.advance_attempts   = counters.advance_attempts.get();
+        s.advances           = counters.advances.get();
+        s.deferreds_executed = counters.deferreds_executed.get();
+
+        // A bag is counted as pushed before it is published, and collected
+        // after it is popped. Reading every collected count before any
+        // pushed count thus keeps bags_collected <= bags_pushed.
+        s.bags_collected = 0;
+        for (auto i = 0ul; i < shard_count; ++i)
+        {
+            s.bags_collected += shard_at(i).collected.get();
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        s.pending_bags = pending();
+
+        s.bags_pushed = 0;
+        for (auto i = 0ul; i < shard_count; ++i)
+        {
+            s.bags_pushed += shard_at(i).pushed.get();
+        }
+
+        s.global_epoch      = global_epoch.load(std::memory_order_relaxed).get() >> 1;
+        s.participants      = participants.occupied();
+        s.unreclaimed_bytes = unreclaimed();
+
+        return s;
+    }
+
+    auto global::get_fence_mode() const noexcept -> fence_mode
+    {
+        return asymmetric_fences ? fence_mode::asymmetric : fence_mode::symmetric;
+    }
+
+    auto global::synchronize(bool const expedited) -> void
+    {
+        if (nullptr == hyaline)
+        {
+            grace.wait(*this, expedited);
+            return;
+        }
+
+        // Under scheme::hyaline, a bag retired now is executed once every
+        // participant pinned at this point has unpinned; there is no epoch
+        // to drive forward, so an expedited wait is no faster.
+        auto elapsed = std::promise<void>{};
+        after_grace_period(deferred::make([&elapsed]() { elapsed.set_value(); }));
+        elapsed.get_future().wait();
+    }
+
+    auto global::after_grace_period(deferred&& d) -> void
+    {
+        auto b = acquire_bag(nullptr);
+        b->try_push(std::move(d));
+
+        // A bag of one function expires after exactly one grace period;
+        // order the caller's prior stores before it is sealed.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (nullptr != hyaline)
+        {
+            hyaline->retire(std::move(b), nullptr);
+        }
+        else
+        {
+            push_bag(std::move(b), assign_shard());
+        }
+    }
+
+    auto global::get_scheme() const noexcept -> scheme
+    {
+        return (nullptr != hyaline) ? scheme::hyaline : scheme::epoch;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+// grace.cpp
+
+#include <epic/grace.hpp>
+#include <epic/global.hpp>
+#include <epic/backoff.hpp>
+
+#include <thread>
+#include <cstdint>
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+namespace epic
+{
+    grace_periods::grace_periods()
+        : lock{}
+        , driver_done{}
+        , driving{false}
+        , expedited_waiters{0}
+        , event_fd{-1}
+    {}
+
+    grace_periods::~grace_periods()
+    {
+        auto const f = event_fd.load(std::memory_order_relaxed);
+        if (f >= 0)
+        {
+            ::close(f);
+        }
+    }
+
+    auto grace_periods::fd() -> int
+    {
+        auto current = event_fd.load(std::memory_order_acquire);
+        if (current >= 0)
+        {
+            return current;
+        }
+
+        auto const created = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (created < 0)
+        {
+            return -1;
+        }
+
+        // Another thread may have created one concurrently; keep theirs.
+        if (!event_fd.compare_exchange_strong(current, created,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            ::close(created);
+            return current;
+        }
+
+        return created;
+    }
+
+    auto grace_periods::signal() noexcept -> void
+    {
+        auto const one = std::uint64_t{1};
+
+        // Fails only if the counter would overflow, in which
+        // case the eventfd is readable already.
+        auto const f = event_fd.load(std::memory_order_acquire);
+        [[maybe_unused]] auto const written = ::write(f, &one, sizeof(one));
+    }
+
+    auto grace_periods::wait(global& g, bool const expedited) -> void
+    {
+        // Order the caller's prior stores (unlinking whatever the readers
+        // must no longer see) before the load of the epoch.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto const start = g.global_epoch.load(std::memory_order_relaxed);
+
+        auto const done = [&g, start]() -> bool
+        {
+            return g.global_epoch.load(std::memory_order_acquire).wrapping_sub(start) >= 2;
+        };
+
+        if (expedited)
+        {
+            expedited_waiters.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto l = std::unique_lock{lock};
+        while (!done())
+        {
+            if (driving)
+            {
+                // Another caller is advancing the epoch; its grace period
+                // ends no later than ours, so check back periodically.
+                driver_done.wait_for(l, POLL_INTERVAL);
+                continue;
+            }
+
+            driving = true;
+            l.unlock();
+
+            drive(g, done);
+
+            l.lock();
+            driving = false;
+            driver_done.notify_all();
+        }
+
+        l.unlock();
+
+        if (expedited)
+        {
+            expedited_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Done>
+    auto grace_periods::drive(global& g, Done&& done) -> void
+    {
+        auto b = backoff{};
+        for (;;)
+        {
+            auto const before = g.global_epoch.load(std::memory_order_relaxed);
+            if (g.try_advance() != before)
+            {
+                b.reset();
+            }
+
+            if (done())
+            {
+                return;
+            }
+
+            if (0 == expedited_waiters.load(std::memory_order_relaxed))
+            {
+                std::this_thread::sleep_for(POLL_INTERVAL);
+            }
+            else if (b.is_completed())
+            {
+                std::this_thread::sleep_for(STRAGGLER_SLEEP);
+            }
+            else
+            {
+                b.snooze();
+            }
+        }
+    }
+}
@@ -18,29 +18,54 @@ namespace epic
             local_ptr->unpin();
         }
     }
-    
-    auto guard::defer(std::function<void()>&& f) -> void
+
+    guard::guard(guard&& g) 
+        : local_ptr{g.local_ptr}
     {
-        if (is_dummy())
+        g.local_ptr = nullptr;
+    }
+
+    guard& guard::operator=(guard&& g)
+    {
+        if (&g != this)
         {
-            // immediately invoke the deferred function for dummy guards
-            f();
+            if (!is_dummy())
+            {
+                local_ptr->unpin();
+            }
+
+            local_ptr   = g.local_ptr;
+            g.local_ptr = nullptr;
         }
-        else
+
+        return *this;
+    }
+    
+    auto guard::defer(deferred&& d, usize_t const bytes) -> defer_status
+    {
+        if (!make_room())
         {
-            // otherwise, add to the thread-local cache
-            local_ptr->defer(std::move(deferred{std::move(f)}), *this);
+            return defer_status::would_exceed;
         }
+
+        defer_unchecked(std::move(d), bytes);
+        return defer_status::ok;
     }
 
-    template <typename T>
-    auto guard::defer_destroy(shared<T>&& ptr) const -> void
+    auto guard::defer_batch(deferred* first, deferred* last, usize_t const bytes) -> defer_status
     {
-        // calling shared::into_owned() on the given `shared` instance
-        // returns an `owned<T>`, which, immediately after it is produced,
-        // falls out of scope and is cleaned up by its destructor
-        // (recall that `shared<T>` does not destroy pointee on destruction)
-        defer([ptr = std::move(ptr)](){ ptr.into_owned(); });
+        if (first == last)
+        {
+            return defer_status::ok;
+        }
+
+        if (!make_room())
+        {
+            return defer_status::would_exceed;
+        }
+
+        defer_many_unchecked(first, static_cast<usize_t>(last - first), bytes);
+        return defer_status::ok;
     }
 
     auto guard::flush() -> void
@@ -79,6 +104,47 @@ namespace epic
         return f();
     } 
 
+    auto guard::make_room() -> bool
+    {
+        // dummy guards execute deferred functions immediately
+        return is_dummy() || local_ptr->make_room();
+    }
+
+    auto guard::defer_unchecked(deferred&& d, usize_t const bytes) -> void
+    {
+        if (is_dummy())
+        {
+            // immediately invoke the deferred function for dummy guards
+            d.call();
+        }
+        else
+        {
+            // otherwise, add to the thread-local cache
+            local_ptr->defer(std::move(d), bytes, *this);
+        }
+    }
+
+    auto guard::defer_many_unchecked(deferred* first, usize_t const n, usize_t const bytes) -> void
+    {
+        if (0 == n)
+        {
+            return;
+        }
+
+        if (is_dummy())
+        {
+            // immediately invoke the deferred functions for dummy guards
+            for (auto i = 0ul; i < n; ++i)
+            {
+                first[i].call();
+            }
+        }
+        else
+        {
+            local_ptr->defer_many(first, n, bytes, *this);
+        }
+    }
+
     auto guard::is_dummy() const noexcept -> bool
     {
         return nullptr == local_ptr;
@@ -0,0 +1,300 @@
+// hazard.cpp
+
+#include <epic/hazard.hpp>
+
+#include <cassert>
+#include <stdexcept>
+#include <algorithm>
+
+namespace epic
+{
+    hazard_record::hazard_record()
+        : hazards{}
+        , held{}
+        , active{true}
+        , next{nullptr}
+    {
+        clear();
+        for (auto& h : held)
+        {
+            h.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    auto hazard_record::clear() noexcept -> void
+    {
+        for (auto& h : hazards)
+        {
+            h.store(0, std::memory_order_release);
+        }
+    }
+
+    hazard_hold::hazard_hold()
+        : local_ptr{nullptr}
+        , index{0} {}
+
+    hazard_hold::hazard_hold(hazard_local* local_ptr_, usize_t const index_)
+        : local_ptr{local_ptr_}
+        , index{index_} {}
+
+    hazard_hold::~hazard_hold()
+    {
+        if (nullptr != local_ptr)
+        {
+            local_ptr->release(index);
+        }
+    }
+
+    hazard_hold::hazard_hold(hazard_hold&& h)
+        : local_ptr{h.local_ptr}
+        , index{h.index}
+    {
+        h.local_ptr = nullptr;
+    }
+
+    hazard_hold& hazard_hold::operator=(hazard_hold&& h)
+    {
+        if (&h != this)
+        {
+            if (nullptr != local_ptr)
+            {
+                local_ptr->release(index);
+            }
+
+            local_ptr   = h.local_ptr;
+            index       = h.index;
+            h.local_ptr = nullptr;
+        }
+
+        return *this;
+    }
+
+    hazard_domain::hazard_domain()
+        : head{nullptr}
+        , record_count{0}
+        , orphan_lock{}
+        , orphans{}
+    {}
+
+    hazard_domain::~hazard_domain()
+    {
+        for (auto const& r : orphans)
+        {
+            r.drop(r.raw);
+        }
+
+        auto* r = head.load(std::memory_order_relaxed);
+        while (nullptr != r)
+        {
+            auto* const next = r->next;
+            delete r;
+            r = next;
+        }
+    }
+
+    auto hazard_domain::participants() const noexcept -> usize_t
+    {
+        return record_count.load(std::memory_order_relaxed);
+    }
+
+    auto hazard_domain::acquire_record() -> hazard_record&
+    {
+        // Reuse the record of a finalized participant, if any.
+        for (auto* r = head.load(std::memory_order_acquire); nullptr != r; r = r->next)
+        {
+            auto expected = false;
+            if (!r->active.load(std::memory_order_relaxed)
+             && r->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return *r;
+            }
+        }
+
+        // Otherwise publish a new (active) record at the head of the list.
+        auto* r = new hazard_record{};
+        auto* h = head.load(std::memory_order_relaxed);
+        do
+        {
+            r->next = h;
+        } while (!head.compare_exchange_weak(h, r,
+            std::memory_order_release, std::memory_order_relaxed));
+
+        record_count.fetch_add(1, std::memory_order_relaxed);
+        return *r;
+    }
+
+    auto hazard_domain::release_record(hazard_record& r) noexcept -> void
+    {
+        r.clear();
+        r.active.store(false, std::memory_order_release);
+    }
+
+    auto hazard_domain::scan_threshold() const noexcept -> usize_t
+    {
+        auto const hazards = record_count.load(std::memory_order_relaxed)*hazard_record::SLOTS;
+        return std::max(2*hazards, 64ul);
+    }
+
+    auto hazard_domain::collect_hazards(std::vector<usize_t>& out) const -> void
+    {
+        out.clear();
+        for (auto* r = head.load(std::memory_order_acquire); nullptr != r; r = r->next)
+        {
+            // The holds are read after the slots used by loads: a pointer
+            // moved into a hold is seen in one or the other.
+            for (auto const& h : r->hazards)
+            {
+                auto const raw = h.load(std::memory_order_acquire);
+                if (0 != raw)
+                {
+                    out.push_back(raw);
+                }
+            }
+
+            for (auto const& h : r->held)
+            {
+                auto const raw = h.load(std::memory_order_acquire);
+                if (0 != raw)
+                {
+                    out.push_back(raw);
+                }
+            }
+        }
+
+        std::sort(out.begin(), out.end());
+    }
+
+    auto hazard_domain::orphan(std::vector<retired_ptr>&& retired) -> void
+    {
+        auto const lock = std::lock_guard{orphan_lock};
+        orphans.insert(orphans.end(), retired.begin(), retired.end());
+        retired.clear();
+    }
+
+    auto hazard_domain::adopt_orphans(std::vector<retired_ptr>& retired) -> void
+    {
+        auto lock = std::unique_lock{orphan_lock, std::try_to_lock};
+        if (lock.owns_lock() && !orphans.empty())
+        {
+            retired.insert(retired.end(), orphans.begin(), orphans.end());
+            orphans.clear();
+        }
+    }
+
+    hazard_local::hazard_local(hazard_domain& domain_)
+        : domain{domain_}
+        , record{domain_.acquire_record()}
+        , retired{}
+        , scratch{}
+        , guard_count{0}
+        , next_slot{0}
+        , holds_in_use{0}
+        , overwrites{0}
+    {}
+
+    hazard_local::~hazard_local()
+    {
+        assert(0 == guard_count);
+        assert(0 == holds_in_use);
+
+        domain.release_record(record);
+        scan();
+
+        if (!retired.empty())
+        {
+            domain.orphan(std::move(retired));
+        }
+    }
+
+    auto hazard_local::enter() noexcept -> void
+    {
+        ++guard_count;
+    }
+
+    auto hazard_local::leave() noexcept -> void
+    {
+        if (0 == --guard_count)
+        {
+            record.clear();
+            next_slot = 0;
+        }
+    }
+
+    auto hazard_local::hold(usize_t const raw) -> usize_t
+    {
+        auto const& slots = record.hazards;
+        assert(0 == raw || std::any_of(slots.begin(), slots.end(),
+            [raw](atomic_usize_t const& h) { return h.load(std::memory_order_relaxed) == raw; }));
+
+        for (auto i = 0ul; i < hazard_record::HOLDS; ++i)
+        {
+            if (0 == (holds_in_use & (1ul << i)))
+            {
+                holds_in_use |= (1ul << i);
+
+                // Ordered before any later store that releases the slot
+                // currently protecting `raw` (see collect_hazards()).
+                record.held[i].store(raw, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                return i;
+            }
+        }
+
+        throw std::runtime_error{"all hazard holds are in use"};
+    }
+
+    auto hazard_local::release(usize_t const index) noexcept -> void
+    {
+        assert(0 != (holds_in_use & (1ul << index)));
+
+        record.held[index].store(0, std::memory_order_release);
+        holds_in_use &= ~(1ul << index);
+    }
+
+    auto hazard_local::overwritten() const noexcept -> usize_t
+    {
+        return overwrites;
+    }
+
+    auto hazard_local::retire(retired_ptr const r) -> void
+    {
+        retired.push_back(r);
+        if (retired.size() >= domain.scan_threshold())
+        {
+            scan();
+        }
+    }
+
+    auto hazard_local::scan() -> usize_t
+    {
+        domain.adopt_orphans(retired);
+
+        // Order the unlinking of the retired objects before
+        // the loads of the hazard pointers below.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        domain.collect_hazards(scratch);
+
+        // Keep the protected objects at the front, drop the rest.
+        auto const split = std::partition(retired.begin(), retired.end(),
+            [this](retired_ptr const& r)
+            {
+                return std::binary_search(scratch.begin(), scratch.end(), r.raw);
+            });
+
+        // Dropping an object may retire others; take them out first.
+        auto const doomed = std::vector<retired_ptr>(split, retired.end());
+        retired.erase(split, retired.end());
+
+        for (auto const& r : doomed)
+        {
+            r.drop(r.raw);
+        }
+
+        return doomed.size();
+    }
+
+    auto hazard_local::pending() const noexcept -> usize_t
+    {
+        return retired.size();
+    }
+}
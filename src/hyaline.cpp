@@ -0,0 +1,117 @@
+// hyaline.cpp
+
+#include <epic/hyaline.hpp>
+#include <epic/global.hpp>
+
+#include <vector>
+
+namespace epic
+{
+    // The pinned participants observed by the current retire(); kept
+    // per thread so that sealing a bag does not allocate for it.
+    static thread_local std::vector<atomic_usize_t*> pinned_heads{};
+
+    hyaline_batch::hyaline_batch(std::unique_ptr<bag>&& contents_, usize_t const node_count)
+        : contents{std::move(contents_)}
+        , refs{0}
+        , nodes{std::make_unique<hyaline_node[]>(node_count)}
+    {}
+
+    hyaline_domain::hyaline_domain(global& owner_)
+        : owner{owner_} {}
+
+    auto hyaline_domain::enter(atomic_usize_t& head) noexcept -> void
+    {
+        // The list is empty while unpinned: batches are only linked into
+        // the lists of pinned participants, and leave() detaches the list.
+        //
+        // Sequentially consistent, so that a concurrent retire() either
+        // observes the pin or precedes every load made under it.
+        head.store(ACTIVE, std::memory_order_seq_cst);
+    }
+
+    auto hyaline_domain::leave(atomic_usize_t& head, bag_pool* pool) -> void
+    {
+        auto const list = head.exchange(0, std::memory_order_acq_rel);
+
+        auto* node = reinterpret_cast<hyaline_node*>(list & ~ACTIVE);
+        while (nullptr != node)
+        {
+            // Releasing the batch may free the node.
+            auto* const next = node->next;
+            release(node->batch, 1, pool);
+            node = next;
+        }
+    }
+
+    auto hyaline_domain::retire(std::unique_ptr<bag>&& b, bag_pool* pool) -> void
+    {
+        if (b->is_empty())
+        {
+            owner.recycle_bag(std::move(b), pool);
+            return;
+        }
+
+        // Order the unlinking of the garbage before the loads of the list
+        // heads below: a participant that pins later cannot reach it.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto& heads = pinned_heads;
+        heads.clear();
+        owner.participants.for_each_occupied([&heads](participant_slot& s)
+        {
+            if (0 != (s.batches.load(std::memory_order_relaxed) & ACTIVE))
+            {
+                heads.push_back(&s.batches);
+            }
+        });
+
+        if (heads.empty())
+        {
+            owner.execute_bag(std::move(b), pool);
+            return;
+        }
+
+        // Link a node into the list of every participant that is still
+        // pinned; one that has unpinned since is skipped, and one that
+        // pinned anew only makes the batch live longer.
+        auto* batch = new hyaline_batch{std::move(b), heads.size()};
+        auto inserted = isize_t{0};
+        for (auto* head : heads)
+        {
+            auto& node = batch->nodes[inserted];
+            node.batch = batch;
+
+            auto list = head->load(std::memory_order_relaxed);
+            do
+            {
+                if (0 == (list & ACTIVE))
+                {
+                    break;
+                }
+
+                node.next = reinterpret_cast<hyaline_node*>(list & ~ACTIVE);
+            } while (!head->compare_exchange_weak(list, reinterpret_cast<usize_t>(&node) | ACTIVE,
+                std::memory_order_acq_rel, std::memory_order_relaxed));
+
+            if (0 != (list & ACTIVE))
+            {
+                ++inserted;
+            }
+        }
+
+        // Participants may already have unpinned and released their
+        // references, taking the count below zero; adding the number
+        // of lists entered balances it.
+        release(batch, -inserted, pool);
+    }
+
+    auto hyaline_domain::release(hyaline_batch* b, isize_t const n, bag_pool* pool) -> void
+    {
+        if (b->refs.fetch_sub(n, std::memory_order_acq_rel) == n)
+        {
+            owner.execute_bag(std::move(b->contents), pool);
+            delete b;
+        }
+    }
+}
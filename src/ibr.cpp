@@ -0,0 +1,209 @@
+// ibr.cpp
+
+#include <epic/ibr.hpp>
+
+#include <cassert>
+#include <algorithm>
+
+namespace epic
+{
+    era_record::era_record()
+        : lower{NONE}
+        , upper{NONE}
+        , active{true}
+        , next{nullptr}
+    {}
+
+    auto era_record::clear() noexcept -> void
+    {
+        // Clear the lower bound first: a scan that observes
+        // it and a stale upper bound reserves too much, not too little.
+        lower.store(NONE, std::memory_order_release);
+        upper.store(NONE, std::memory_order_release);
+    }
+
+    era_domain::era_domain()
+        : head{nullptr}
+        , record_count{0}
+        , orphan_lock{}
+        , orphans{}
+    {}
+
+    era_domain::~era_domain()
+    {
+        for (auto const& b : orphans)
+        {
+            b.drop(b.raw);
+        }
+
+        auto* r = head.load(std::memory_order_relaxed);
+        while (nullptr != r)
+        {
+            auto* const next = r->next;
+            delete r;
+            r = next;
+        }
+    }
+
+    auto era_domain::participants() const noexcept -> usize_t
+    {
+        return record_count.load(std::memory_order_relaxed);
+    }
+
+    auto era_domain::acquire_record() -> era_record&
+    {
+        // Reuse the record of a finalized participant, if any.
+        for (auto* r = head.load(std::memory_order_acquire); nullptr != r; r = r->next)
+        {
+            auto expected = false;
+            if (!r->active.load(std::memory_order_relaxed)
+             && r->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                return *r;
+            }
+        }
+
+        // Otherwise publish a new (active) record at the head of the list.
+        auto* r = new era_record{};
+        auto* h = head.load(std::memory_order_relaxed);
+        do
+        {
+            r->next = h;
+        } while (!head.compare_exchange_weak(h, r,
+            std::memory_order_release, std::memory_order_relaxed));
+
+        record_count.fetch_add(1, std::memory_order_relaxed);
+        return *r;
+    }
+
+    auto era_domain::release_record(era_record& r) noexcept -> void
+    {
+        r.clear();
+        r.active.store(false, std::memory_order_release);
+    }
+
+    auto era_domain::collect_reservations(std::vector<era_reservation>& out) const -> void
+    {
+        out.clear();
+        for (auto* r = head.load(std::memory_order_acquire); nullptr != r; r = r->next)
+        {
+            auto const lower = r->lower.load(std::memory_order_acquire);
+            if (era_record::NONE != lower)
+            {
+                out.push_back(era_reservation{lower, r->upper.load(std::memory_order_acquire)});
+            }
+        }
+    }
+
+    auto era_domain::orphan(std::vector<retired_block>&& retired) -> void
+    {
+        auto const lock = std::lock_guard{orphan_lock};
+        orphans.insert(orphans.end(), retired.begin(), retired.end());
+        retired.clear();
+    }
+
+    auto era_domain::adopt_orphans(std::vector<retired_block>& retired) -> void
+    {
+        auto lock = std::unique_lock{orphan_lock, std::try_to_lock};
+        if (lock.owns_lock() && !orphans.empty())
+        {
+            retired.insert(retired.end(), orphans.begin(), orphans.end());
+            orphans.clear();
+        }
+    }
+
+    era_local::era_local(era_domain& domain_)
+        : domain{domain_}
+        , record{domain_.acquire_record()}
+        , retired{}
+        , scratch{}
+        , guard_count{0}
+        , retire_count{0}
+    {}
+
+    era_local::~era_local()
+    {
+        assert(0 == guard_count);
+
+        domain.release_record(record);
+        scan();
+
+        if (!retired.empty())
+        {
+            domain.orphan(std::move(retired));
+        }
+    }
+
+    auto era_local::enter() noexcept -> void
+    {
+        if (0 == guard_count++)
+        {
+            auto const era = era_clock().load(std::memory_order_acquire);
+            record.lower.store(era, std::memory_order_relaxed);
+            record.upper.store(era, std::memory_order_relaxed);
+
+            // Order the reservation before any load under the guard.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    auto era_local::leave() noexcept -> void
+    {
+        if (0 == --guard_count)
+        {
+            record.clear();
+        }
+    }
+
+    auto era_local::retire(retired_block b) -> void
+    {
+        b.retire_era = era_clock().load(std::memory_order_acquire);
+        retired.push_back(b);
+
+        // Advance the era periodically, so that objects allocated from
+        // now on are not covered by the reservations of stalled readers.
+        if (0 == (++retire_count % ERA_FREQUENCY))
+        {
+            era_clock().fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        if (retired.size() >= SCAN_THRESHOLD)
+        {
+            scan();
+        }
+    }
+
+    auto era_local::scan() -> usize_t
+    {
+        domain.adopt_orphans(retired);
+
+        // Order the unlinking of the retired objects before
+        // the loads of the reservations below.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        domain.collect_reservations(scratch);
+
+        // Keep the reserved objects at the front, drop the rest.
+        auto const split = std::partition(retired.begin(), retired.end(),
+            [this](retired_block const& b)
+            {
+                return std::any_of(scratch.begin(), scratch.end(),
+                    [&b](era_reservation const& r) { return r.overlaps(b); });
+            });
+
+        // Dropping an object may retire others; take them out first.
+        auto const doomed = std::vector<retired_block>(split, retired.end());
+        retired.erase(split, retired.end());
+
+        for (auto const& b : doomed)
+        {
+            b.drop(b.raw);
+        }
+
+        return doomed.size();
+    }
+
+    auto era_local::pending() const noexcept -> usize_t
+    {
+        return retired.size();
+    }
+}
@@ -6,27 +6,68 @@
 #include <epic/global.hpp>
 #include <epic/collector.hpp>
 #include <epic/local_handle.hpp>
+#include <epic/membarrier.hpp>
+#include <epic/backoff.hpp>
+#include <epic/trace.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 
 namespace epic
 {
-    local::local(collector& c) 
-        : entry{}
-        , local_epoch{epoch{}}
+    // The time to sleep between collections once a participant that is
+    // blocked on the garbage cap has exhausted its backoff.
+    constexpr static auto const BLOCKED_SLEEP = std::chrono::microseconds{100};
+
+    local::local(collector& c, bool reader_only_, bool qsbr_) 
+        : slot{c.instance->participants.acquire()}
+        , local_epoch{c.instance->participants.at(slot).local_epoch}
+        , counters{c.instance->participants.at(slot).counters}
         , instance{c}
-        , deferreds{std::make_unique<bag>()}
+        , deferreds{c.instance->acquire_bag(nullptr)}
+        , trim_seen{c.instance->trim_generation.load(std::memory_order_relaxed)}
         , guard_count{0}
-        , handle_count{0}
+        , handle_count{1}
         , pin_count{0}
-    {}
+        , reader_only{reader_only_}
+        , qsbr{qsbr_}
+        , online{false}
+        , shard{c.instance->assign_shard()}
+        , asymmetric_fences{c.instance->asymmetric_fences}
+        , hyaline{c.instance->hyaline.get()}
+        , batches{c.instance->participants.at(slot).batches}
+        , free_bags{}
+    {
+        c.instance->participants.at(slot).owner.store(
+            std::this_thread::get_id(), std::memory_order_relaxed);
+
+        // Verify the layout described in local.hpp.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+        static_assert(alignof(local) == CACHE_LINE_SIZE,
+            "participants must not share cache lines");
+        static_assert(offsetof(local, guard_count) + sizeof(guard_count) <= CACHE_LINE_SIZE
+            && offsetof(local, pin_count) + sizeof(pin_count) <= CACHE_LINE_SIZE
+            && offsetof(local, asymmetric_fences) < CACHE_LINE_SIZE
+            && offsetof(local, batches) + sizeof(usize_t) <= CACHE_LINE_SIZE,
+            "the fields used by pin() must fit in the first cache line");
+#pragma GCC diagnostic pop
+    }
 
-    auto local::register_handle(collector& c) -> local_handle
+    auto local::register_handle(collector& c, bool reader_only, bool qsbr) -> local_handle
     {
-        // construct a new local instance on the heap
-        auto* l = new local{c};
+        // construct a new local instance on the heap;
+        // the constructor claims a slot in the global registry
+        auto* l = new local{c, reader_only, qsbr};
 
-        // insert the new local into the global list of `local`s
-        lowlock::list::push_front(
-            c.instance->locals, local::entry_of(*l));
+        // a QSBR participant starts online, pinned in the current epoch
+        if (qsbr)
+        {
+            l->go_online();
+        }
 
         // return a `local_handle` that refers to the `local` instance.
         return local_handle{l};
@@ -47,28 +88,65 @@ namespace epic
         return local_epoch.load(std::memory_order_relaxed);
     }
 
+    auto local::get_slot() const noexcept -> usize_t
+    {
+        return slot;
+    }
+
+    auto local::get_guard_count() const noexcept -> usize_t
+    {
+        return guard_count.get();
+    }
+
     auto local::is_pinned() const -> bool
     {
         return guard_count.get() > 0;
     }
 
-    auto local::defer(deferred&& d, guard& g) -> void
+    auto local::collect_period(usize_t const pending) noexcept -> usize_t
     {
+        if (0 == pending)
+        {
+            return 0;
+        }
+
+        // The backlog in units of COLLECT_STEPS bags; every
+        // doubling of the backlog halves the collection period.
+        auto const units = pending / global::COLLECT_STEPS;
+        auto const shift = (0 == units) 
+            ? 0ul 
+            : std::min<usize_t>(
+                sizeof(usize_t)*CHAR_BIT - __builtin_clzl(units), 
+                __builtin_ctzl(PINNINGS_BETWEEN_COLLECT));
+
+        return PINNINGS_BETWEEN_COLLECT >> shift;
+    }
+
+    auto local::is_reader_only() const noexcept -> bool
+    {
+        return reader_only;
+    }
+
+    auto local::defer(deferred&& d, usize_t const bytes, guard& g) -> void
+    {
+        counters.deferreds.bump();
+
+        auto crossed = false;
         for (;;)
         {
             // Attempt to add the deferred function to the thread local bag.
-            auto def = deferreds->try_push(std::move(d));
+            auto def = deferreds->try_push(std::move(d), bytes);
             if (def.has_value())
             {
                 // Push of the deferred to thread local bag failed
                 // because the bag is full, seal the bag and
                 // push it onto the global queue
                 
-                // Create a new bag and swap it with the full one.
-                auto new_bag = std::make_unique<bag>();
+                // Take an empty bag and swap it with the full one.
+                auto new_bag = fresh_bag();
                 deferreds.swap(new_bag);
                 
-                get_global().push_bag(std::move(new_bag));
+                crossed |= seal_bag(std::move(new_bag));
 
                 d = std::move(def.value());
             }
@@ -78,19 +156,150 @@ namespace epic
                 break;
             }
         }
+
+        // Crossing the byte threshold forces collection rather
+        // than waiting for the pin count to trigger it.
+        if (0 != bytes && (crossed || crosses_threshold(bytes)))
+        {
+            relieve_pressure();
+        }
+    }
+
+    auto local::defer_many(deferred* first, usize_t n, usize_t const bytes, guard& g) -> void
+    {
+        counters.deferreds.bump(n);
+
+        // Each bag is attributed the share of the bytes of the functions it receives.
+        auto unattributed = bytes;
+        auto crossed      = false;
+        for (;;)
+        {
+            auto const moved = deferreds->push_many(first, n, unattributed);
+            unattributed -= bytes_share(unattributed, moved, n);
+
+            first += moved;
+            n     -= moved;
+
+            if (0 == n)
+            {
+                break;
+            }
+
+            // The local bag is full; seal it and continue with an empty one.
+            auto new_bag = fresh_bag();
+            deferreds.swap(new_bag);
+
+            crossed |= seal_bag(std::move(new_bag));
+        }
+
+        if (0 != bytes && (crossed || crosses_threshold(bytes)))
+        {
+            relieve_pressure();
+        }
     }
 
     auto local::flush(guard& g) -> void
     {
         if (!deferreds->is_empty())
         {
-            auto new_bag = std::make_unique<bag>();
+            auto new_bag = fresh_bag();
+            deferreds.swap(new_bag);
+
+            seal_bag(std::move(new_bag));
+        }
+
+        // Reader-only participants leave collection to others.
+        if (!reader_only)
+        {
+            get_global().collect(shard, pool());
+        }
+    }
+
+    auto local::make_room() -> bool
+    {
+        // Only sealing the local bag adds to the global backlog.
+        if (!deferreds->is_full())
+        {
+            return true;
+        }
+
+        auto& gl = get_global();
+
+        auto const cap = gl.garbage_cap.load(std::memory_order_relaxed);
+        if (0 == cap || gl.pending() < cap)
+        {
+            return true;
+        }
+
+        switch (gl.policy.load(std::memory_order_relaxed))
+        {
+        case backpressure::reject:
+            return false;
+
+        case backpressure::advance:
+            // Reader-only participants leave collection to others;
+            // they may still try to move the epoch along.
+            if (reader_only)
+            {
+                gl.try_advance();
+            }
+            else
+            {
+                gl.collect(shard, USIZE_MAX, pool());
+            }
+            return true;
+
+        case backpressure::block:
+        default:
+            break;
+        }
+
+        // Wait for the backlog to drain or for the epoch to advance. We are
+        // pinned, so we cannot wait for more than one advance: the epoch
+        // cannot move past the one after the epoch in which we are pinned.
+        auto const pinned_in = local_epoch.load(std::memory_order_relaxed).unpinned();
+
+        auto b = backoff{};
+        while (gl.pending() >= cap
+            && gl.global_epoch.load(std::memory_order_relaxed) == pinned_in)
+        {
+            if (reader_only)
+            {
+                gl.try_advance();
+            }
+            else
+            {
+                gl.collect(shard, USIZE_MAX, pool());
+            }
+
+            if (b.is_completed())
+            {
+                std::this_thread::sleep_for(BLOCKED_SLEEP);
+            }
+            else
+            {
+                b.snooze();
+            }
+        }
+
+        return true;
+    }
+
+    auto local::relieve_pressure() -> void
+    {
+        if (0 != deferreds->size_in_bytes())
+        {
+            auto new_bag = fresh_bag();
             deferreds.swap(new_bag);
 
-            get_global().push_bag(std::move(new_bag));
+            seal_bag(std::move(new_bag));
         }
 
-        get_global().collect();
+        // Reader-only participants leave collection to others.
+        if (!reader_only)
+        {
+            get_global().collect(shard, USIZE_MAX, pool());
+        }
     }
 
     auto local::pin() -> guard
@@ -99,41 +308,146 @@ namespace epic
 
         auto const count = guard_count.get();
         guard_count.set(count + 1);
+        counters.pins.bump();
 
         if (0 == count)
         {
+            counters.outermost_pins.bump();
+
             // Previously, the gaurd count for this `local` was 0, 
             // so this participant becomes pinned in the current global epoch.
+            auto const pinned = publish_pinned();
+            trace_event(trace_kind::pin, pinned.get() >> 1);
 
-            auto global_epoch = get_global().global_epoch.load(std::memory_order_relaxed);
-            auto new_epoch = global_epoch.pinned();
-
-            // Store the new global epoch.
-            local_epoch.store(new_epoch, std::memory_order_seq_cst);
+            maybe_collect();
+        }
 
-            // Increment the local pin count.
-            auto p_count = pin_count.get();
-            pin_count.set(p_count + 1);
+        return g;
+    }
 
-            // After every `PINNINGS_BETWEEN_COLLECT` try to 
-            // advanced the epoch and collecting some garbage.
-            if (0 == p_count % PINNINGS_BETWEEN_COLLECT)
+    auto local::maybe_collect() -> void
+    {
+        // Increment the local pin count.
+        auto p_count = pin_count.get();
+        pin_count.set(p_count + 1);
+
+        // Periodically try to advance the epoch and collect some garbage;
+        // the period shrinks as the global backlog of bags grows, and
+        // there is nothing to do at all when no bags are pending.
+        //
+        // Under memory pressure, collect on every pin instead.
+        if (!reader_only)
+        {
+            auto const pending = get_global().pending(shard);
+            auto const period  = collect_period(pending);
+            if (get_global().is_under_pressure())
             {
-                get_global().collect();
+                relieve_pressure();
+            }
+            else if (0 != period && 0 == (p_count & (period - 1)))
+            {
+                get_global().collect(shard, pool());
             }
         }
+    }
 
-        return g;
+    auto local::quiescent() -> void
+    {
+        assert(qsbr);
+
+        // Offline participants have nothing to report.
+        if (!online.get())
+        {
+            return;
+        }
+
+        // Only the implicit pin may be held: a guard could still
+        // hold references obtained in the current epoch.
+        assert(1 == guard_count.get());
+
+        repin();
+        maybe_collect();
+    }
+
+    auto local::go_offline() -> void
+    {
+        assert(qsbr && online.get());
+        assert(1 == guard_count.get());
+
+        online.set(false);
+        unpin();
+    }
+
+    auto local::go_online() -> void
+    {
+        assert(qsbr && !online.get());
+        assert(0 == guard_count.get());
+
+        online.set(true);
+        guard_count.set(1);
+
+        auto const pinned = publish_pinned();
+        trace_event(trace_kind::pin, pinned.get() >> 1);
+    }
+
+    auto local::is_qsbr() const noexcept -> bool
+    {
+        return qsbr;
     }
     
+    auto local::resume() -> void
+    {
+        assert(guard_count.get() > 0);
+        publish_pinned();
+    }
+
+    auto local::publish_pinned() -> epoch
+    {
+        // Under scheme::hyaline there is no epoch to publish;
+        // pinning only marks the participant's list as active.
+        if (nullptr != hyaline)
+        {
+            hyaline->enter(batches);
+            return epoch{};
+        }
+
+        auto global_epoch = get_global().global_epoch.load(std::memory_order_relaxed);
+        auto new_epoch = global_epoch.pinned();
+
+        // Store the new global epoch.
+        //
+        // Under asymmetric fences a plain store suffices; the matching
+        // heavy fence is issued by global::try_advance() via membarrier().
+        if (asymmetric_fences)
+        {
+            local_epoch.store(new_epoch, std::memory_order_relaxed);
+            membarrier_light();
+        }
+        else
+        {
+            local_epoch.store(new_epoch, std::memory_order_seq_cst);
+        }
+
+        return new_epoch;
+    }
+
     auto local::unpin() -> void
     {
         auto const count = guard_count.get();
-        guard_count.set(count + 1);
+        guard_count.set(count - 1);
 
         if (1 == count)
         {
-            local_epoch.store(epoch{}, std::memory_order_release);
+            if (nullptr != hyaline)
+            {
+                hyaline->leave(batches, pool());
+            }
+            else
+            {
+                local_epoch.store(epoch{}, std::memory_order_release);
+            }
+
+            trace_event(trace_kind::unpin);
 
             if (0 == handle_count.get())
             {
@@ -147,7 +461,13 @@ namespace epic
         auto const count = guard_count.get();
 
         // Update the local epoch if there is only one guard.
-        if (1 == count)
+        if (1 == count && nullptr != hyaline)
+        {
+            // Release the batches sealed so far, then pin anew.
+            hyaline->leave(batches, pool());
+            hyaline->enter(batches);
+        }
+        else if (1 == count)
         {
             auto l_epoch = local_epoch.load(std::memory_order_relaxed);
             auto g_epoch = get_global().global_epoch.load(std::memory_order_relaxed).pinned();
@@ -176,6 +496,15 @@ namespace epic
 
         handle_count.set(h_count - 1);
 
+        // The last handle of a QSBR participant drops its implicit pin;
+        // this finalizes the participant unless a guard is still alive.
+        if (1 == h_count && online.get())
+        {
+            online.set(false);
+            unpin();
+            return;
+        }
+
         if (0 == g_count && 1 == h_count)
         {
             finalize();
@@ -196,30 +525,84 @@ namespace epic
         handle_count.set(1);
 
         // Pin and move the local bag to the global queue.
-        auto g = pin();
-        get_global().push_bag(std::move(deferreds));
+        // The guard must be dropped before the handle count is
+        // reset, otherwise unpinning would finalize us again.
+        {
+            auto g = pin();
+            seal_bag(std::move(deferreds));
+        }
 
         handle_count.set(0);
 
-        // Remove the entry for this local from the linked list.
-        auto& global_list = get_global().locals;
-        lowlock::list::remove_entry(global_list, &entry);
+        // Hand the recycled bags over to the shared free pool.
+        while (auto b = free_bags.take())
+        {
+            get_global().recycle_bag(std::move(b), nullptr);
+        }
 
-        // Drop the reference to the global shared state.
-        instance.release();
+        // Release the registry slot for reuse by another participant.
+        get_global().participants.release(slot);
+
+        // Nothing refers to this participant anymore; destroying it
+        // drops the reference to the global shared state.
+        delete this;
     }
 
-    auto local::entry_of(local& l) -> lowlock::list_entry&
+    auto local::crosses_threshold(usize_t const bytes) const noexcept -> bool
     {
-        auto* entry_ptr = reinterpret_cast<lowlock::list_entry*>(
-            reinterpret_cast<ptrdiff_t>(&l) + offsetof(local, entry));
-        return *entry_ptr;
+        auto const held = deferreds->size_in_bytes();
+        if (held < bytes)
+        {
+            // The bytes went to a bag that has since been sealed.
+            return false;
+        }
+
+        auto const threshold = get_global().byte_threshold.load(std::memory_order_relaxed);
+        auto const before    = get_global().unreclaimed() + held - bytes;
+        return 0 != threshold && before < threshold && before + bytes >= threshold;
     }
 
-    auto local::element_of(lowlock::list_entry& e) -> local&
+    auto local::seal_bag(std::unique_ptr<bag>&& b) -> bool
     {
-        auto* local_ptr = reinterpret_cast<local*>(
-            reinterpret_cast<usize_t>(&e) - offsetof(local, entry));
-        return *local_ptr;
+        // Account the bytes before the bag is published, so that the
+        // subtraction in global::execute_bag() never comes first.
+        auto const bytes   = b->size_in_bytes();
+        auto const crossed = 0 != bytes && get_global().account_bytes(bytes);
+        if (crossed)
+        {
+            // Pooled bags are memory the collector could give back now that
+            // it is over its byte budget; trim once per crossing, not on
+            // every operation under pressure, so the pools do not thrash.
+            get_global().trim();
+        }
+
+        if (nullptr != hyaline)
+        {
+            hyaline->retire(std::move(b), pool());
+        }
+        else
+        {
+            get_global().push_bag(std::move(b), shard);
+        }
+
+        return crossed;
+    }
+
+    auto local::fresh_bag() -> std::unique_ptr<bag>
+    {
+        return get_global().acquire_bag(pool());
+    }
+
+    auto local::pool() -> bag_pool*
+    {
+        auto const generation = get_global().trim_generation.load(std::memory_order_relaxed);
+        if (generation != trim_seen.get())
+        {
+            // The collector was trimmed under memory pressure.
+            free_bags.clear();
+            trim_seen.set(generation);
+        }
+
+        return &free_bags;
     }
 }
\ No newline at end of file
@@ -10,7 +10,32 @@ namespace epic
 
     local_handle::~local_handle()
     {
-        local_ptr->release_handle();
+        if (nullptr != local_ptr)
+        {
+            local_ptr->release_handle();
+        }
+    }
+
+    local_handle::local_handle(local_handle&& h)
+        : local_ptr{h.local_ptr}
+    {
+        h.local_ptr = nullptr;
+    }
+
+    local_handle& local_handle::operator=(local_handle&& h)
+    {
+        if (&h != this)
+        {
+            if (nullptr != local_ptr)
+            {
+                local_ptr->release_handle();
+            }
+
+            local_ptr   = h.local_ptr;
+            h.local_ptr = nullptr;
+        }
+
+        return *this;
     }
 
     auto local_handle::pin() const -> guard
@@ -18,6 +43,21 @@ namespace epic
         return local_ptr->pin();
     }
 
+    auto local_handle::quiescent() const -> void
+    {
+        local_ptr->quiescent();
+    }
+
+    auto local_handle::offline() const -> void
+    {
+        local_ptr->go_offline();
+    }
+
+    auto local_handle::online() const -> void
+    {
+        local_ptr->go_online();
+    }
+
     auto local_handle::is_pinned() const -> bool
     {
         return local_ptr->is_pinned();
@@ -27,4 +67,9 @@ namespace epic
     {
         return local_ptr->get_collector();
     }
+
+    auto local_handle::get_local() const noexcept -> local*
+    {
+        return local_ptr;
+    }
 }
\ No newline at end of file
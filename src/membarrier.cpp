@@ -0,0 +1,45 @@
+// membarrier.cpp
+
+#include <epic/membarrier.hpp>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/membarrier.h>
+#endif
+
+namespace epic
+{
+#if defined(__linux__) && defined(__NR_membarrier)
+    static auto sys_membarrier(int const cmd) -> int
+    {
+        return static_cast<int>(syscall(__NR_membarrier, cmd, 0, 0));
+    }
+
+    auto membarrier_register() -> bool
+    {
+        auto const supported = sys_membarrier(MEMBARRIER_CMD_QUERY);
+        if (supported < 0 || 0 == (supported & MEMBARRIER_CMD_PRIVATE_EXPEDITED))
+        {
+            return false;
+        }
+
+        return 0 == sys_membarrier(MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED);
+    }
+
+    auto membarrier_heavy() -> bool
+    {
+        return 0 == sys_membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED);
+    }
+#else
+    auto membarrier_register() -> bool
+    {
+        return false;
+    }
+
+    auto membarrier_heavy() -> bool
+    {
+        return false;
+    }
+#endif
+}
@@ -0,0 +1,257 @@
+// neutralize.cpp
+
+#include <epic/neutralize.hpp>
+
+#include <epic/local.hpp>
+#include <epic/global.hpp>
+#include <epic/registry.hpp>
+#include <epic/watchdog.hpp>
+
+#include <mutex>
+
+namespace epic
+{
+    // The innermost checkpoint of the current thread, read by the handler.
+    //
+    // Constant-initialized; the thread writes it (and so allocates its
+    // thread-local storage) before a signal can be directed at it.
+    static thread_local checkpoint* current_checkpoint = nullptr;
+
+    // neutralize_current()
+    // Restarts the current thread's read phase, if it is restartable.
+    //
+    // Only async-signal-safe operations are used: lock-free atomic
+    // stores and siglongjmp().
+    auto neutralize_current(int) -> void
+    {
+        auto* const cp = current_checkpoint;
+        std::atomic_signal_fence(std::memory_order_acquire);
+
+        if (nullptr == cp || 0 == cp->armed)
+        {
+            // Not in a read phase (any more); nothing to do.
+            return;
+        }
+
+        // The handler is shared by every collector in the process: restart
+        // the read phase only if its own collector sent the signal, which
+        // it records in the slot once pthread_kill() has returned.
+        auto& phase = cp->slot->phase;
+        auto state  = phase.load(std::memory_order_acquire);
+        while (read_phase::signalling == state)
+        {
+            state = phase.load(std::memory_order_acquire);
+        }
+
+        if (read_phase::signalled != state
+         || !phase.compare_exchange_strong(state, read_phase::idle, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        cp->armed = 0;
+
+        // Unpin; this is what allows the epoch to advance.
+        cp->slot->local_epoch.store(epoch{}, std::memory_order_release);
+
+        siglongjmp(cp->env, 1);
+    }
+
+    extern "C" void epic_neutralize_handler(int signal)
+    {
+        neutralize_current(signal);
+    }
+
+    // install_handler()
+    // Installs the handler for `signal`, once per signal number.
+    static auto install_handler(int const signal) -> bool
+    {
+        static std::mutex lock{};
+        static sigset_t installed{};
+        static bool initialized = false;
+
+        std::lock_guard<std::mutex> guard{lock};
+        if (!initialized)
+        {
+            sigemptyset(&installed);
+            initialized = true;
+        }
+
+        if (1 == sigismember(&installed, signal))
+        {
+            return true;
+        }
+
+        struct sigaction action{};
+        action.sa_handler = &epic_neutralize_handler;
+        action.sa_flags   = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (0 != sigaction(signal, &action, nullptr))
+        {
+            return false;
+        }
+
+        sigaddset(&installed, signal);
+        return true;
+    }
+
+    neutralizer::neutralizer()
+        : signo{0}
+        , patience{0}
+        , last_advance{0}
+    {}
+
+    auto neutralizer::enable(std::chrono::nanoseconds const after, int signal) -> bool
+    {
+        if (0 == signal)
+        {
+            signal = SIGRTMIN;
+        }
+
+        if (!install_handler(signal))
+        {
+            return false;
+        }
+
+        last_advance.store(watchdog::now(), std::memory_order_relaxed);
+        patience.store(after.count(), std::memory_order_relaxed);
+        signo.store(signal, std::memory_order_release);
+
+        return true;
+    }
+
+    auto neutralizer::disable() noexcept -> void
+    {
+        signo.store(0, std::memory_order_relaxed);
+    }
+
+    auto neutralizer::is_enabled() const noexcept -> bool
+    {
+        return 0 != signo.load(std::memory_order_relaxed);
+    }
+
+    auto neutralizer::on_advance() noexcept -> void
+    {
+        if (is_enabled())
+        {
+            last_advance.store(watchdog::now(), std::memory_order_relaxed);
+        }
+    }
+
+    auto neutralizer::on_stall(registry& participants, usize_t const slot) -> bool
+    {
+        auto const signal = signo.load(std::memory_order_acquire);
+        if (0 == signal)
+        {
+            return false;
+        }
+
+        auto& s = participants.at(slot);
+        if (read_phase::armed != s.phase.load(std::memory_order_relaxed))
+        {
+            // The participant is not in a restartable read phase.
+            return false;
+        }
+
+        auto const stuck_for = watchdog::now() - last_advance.load(std::memory_order_relaxed);
+        if (stuck_for < patience.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        // Claim the read phase: while it is `signalling`, the thread can
+        // neither leave it nor exit, so the pthread_t below stays valid.
+        auto expected = read_phase::armed;
+        if (!s.phase.compare_exchange_strong(expected, read_phase::signalling,
+            std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        // A thread never signals itself: its handler would wait
+        // for this very call to return.
+        auto const target = s.native.load(std::memory_order_relaxed);
+        auto const sent   = 0 == pthread_equal(target, pthread_self())
+                         && 0 == pthread_kill(target, signal);
+
+        s.phase.store(sent ? read_phase::signalled : read_phase::armed, std::memory_order_release);
+        return sent;
+    }
+
+    checkpoint::checkpoint(local_handle const& h)
+        : env{}
+        , owner{h.get_local()}
+        , slot{&owner->get_global().participants.at(owner->get_slot())}
+        , prev{current_checkpoint}
+        , armed{0}
+        , neutralizable{owner->get_global().robust.is_enabled() && 1 == owner->get_guard_count()}
+        , restarts{0}
+    {}
+
+    checkpoint::~checkpoint()
+    {
+        disarm();
+    }
+
+    auto checkpoint::arm() -> void
+    {
+        if (!neutralizable)
+        {
+            return;
+        }
+
+        current_checkpoint = this;
+        slot->native.store(pthread_self(), std::memory_order_relaxed);
+
+        armed = 1;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        slot->phase.store(read_phase::armed, std::memory_order_release);
+    }
+
+    auto checkpoint::disarm() noexcept -> void
+    {
+        if (!neutralizable)
+        {
+            return;
+        }
+
+        // From here on the handler leaves this read phase alone.
+        armed = 0;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+
+        // Wait out a collector that is signalling this thread; once the
+        // phase is idle, it is never signalled again, and may exit.
+        auto state = slot->phase.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (read_phase::signalling == state)
+            {
+                state = slot->phase.load(std::memory_order_relaxed);
+            }
+            else if (slot->phase.compare_exchange_weak(state, read_phase::idle,
+                std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        current_checkpoint = prev;
+    }
+
+    auto checkpoint::resume() -> void
+    {
+        ++restarts;
+        owner->resume();
+    }
+
+    auto checkpoint::is_neutralizable() const noexcept -> bool
+    {
+        return neutralizable;
+    }
+
+    auto checkpoint::restart_count() const noexcept -> usize_t
+    {
+        return restarts;
+    }
+}
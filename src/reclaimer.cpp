@@ -0,0 +1,84 @@
+// reclaimer.cpp
+
+#include <epic/reclaimer.hpp>
+#include <epic/global.hpp>
+
+namespace epic
+{
+    constexpr std::chrono::milliseconds const reclaimer::DEFAULT_INTERVAL;
+
+    reclaimer::reclaimer()
+        : worker{}
+        , control{}
+        , lock{}
+        , wake{}
+        , running{false}
+        , interval{DEFAULT_INTERVAL}
+    {}
+
+    reclaimer::~reclaimer()
+    {
+        stop();
+    }
+
+    auto reclaimer::start(global& g, std::chrono::milliseconds interval_) -> bool
+    {
+        std::lock_guard<std::mutex> serial{control};
+        std::lock_guard<std::mutex> guard{lock};
+        if (running)
+        {
+            return false;
+        }
+
+        running  = true;
+        interval = interval_;
+        worker   = std::thread{[this, &g](){ run(g); }};
+
+        return true;
+    }
+
+    auto reclaimer::stop() -> bool
+    {
+        std::lock_guard<std::mutex> serial{control};
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            if (!running)
+            {
+                return false;
+            }
+
+            running = false;
+        }
+
+        wake.notify_one();
+        worker.join();
+
+        return true;
+    }
+
+    auto reclaimer::is_running() const -> bool
+    {
+        return running.load(std::memory_order_acquire);
+    }
+
+    auto reclaimer::run(global& g) -> void
+    {
+        // The reclaimer has no shard of its own; rotate the shard
+        // it drains first so that all shards are treated fairly.
+        auto home = 0ul;
+
+        std::unique_lock<std::mutex> guard{lock};
+        while (running)
+        {
+            guard.unlock();
+
+            // Drain the global queues for as long as bags keep expiring;
+            // each call to collect() also attempts to advance the epoch.
+            while (running.load(std::memory_order_relaxed) && g.collect(home++, nullptr) > 0)
+            {}
+
+            guard.lock();
+            wake.wait_for(guard, interval, [this](){ return !running; });
+        }
+    }
+}
@@ -0,0 +1,145 @@
+// registry.cpp
+
+#include <epic/registry.hpp>
+
+#include <cassert>
+#include <stdexcept>
+
+namespace epic
+{
+    // Each slot is written by its owner on every pin; it must fill
+    // its cache line exactly so that neighbouring slots never share one.
+    static_assert(sizeof(cache_padded<participant_slot>) == CACHE_LINE_SIZE,
+        "participant slots must occupy exactly one cache line");
+
+    participant_slot::participant_slot()
+        : local_epoch{epoch{}}
+        , batches{0}
+        , owner{std::thread::id{}}
+        , phase{read_phase::idle}
+        , native{pthread_t{}}
+    {}
+
+    registry::chunk::chunk()
+        : occupied{0}
+        , slots{}
+    {}
+
+    registry::registry()
+        : chunks{}
+        , chunk_count{0}
+    {
+        for (auto& c : chunks)
+        {
+            c.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    registry::~registry()
+    {
+        for (auto& c : chunks)
+        {
+            delete c.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto registry::acquire() -> usize_t
+    {
+        for (;;)
+        {
+            auto const count = chunk_count.load(std::memory_order_acquire);
+
+            // Claim the lowest free slot in any existing chunk.
+            for (auto i = 0ul; i < count; ++i)
+            {
+                auto* c = chunks[i].load(std::memory_order_acquire);
+                auto bits = c->occupied.load(std::memory_order_relaxed);
+                while (bits != ~std::uint64_t{0})
+                {
+                    auto const bit = static_cast<usize_t>(__builtin_ctzl(~bits));
+                    if (c->occupied.compare_exchange_weak(
+                        bits, 
+                        bits | (std::uint64_t{1} << bit),
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed))
+                    {
+                        return i*SLOTS_PER_CHUNK + bit;
+                    }
+                }
+            }
+
+            // Every slot is occupied; grow by one chunk.
+            if (MAX_CHUNKS == count)
+            {
+                throw std::runtime_error{"participant registry exhausted"};
+            }
+
+            auto* fresh    = new chunk{};
+            chunk* current = nullptr;
+            if (!chunks[count].compare_exchange_strong(
+                current, fresh, std::memory_order_acq_rel))
+            {
+                // Another thread installed the chunk first.
+                delete fresh;
+            }
+
+            // Publish the new chunk, unless someone else already did.
+            auto expected = count;
+            chunk_count.compare_exchange_strong(
+                expected, count + 1, std::memory_order_acq_rel);
+        }
+    }
+
+    auto registry::release(usize_t const index) -> void
+    {
+        auto& s = at(index);
+        assert(!s.local_epoch.load(std::memory_order_relaxed).is_pinned());
+        s.local_epoch.store(epoch{}, std::memory_order_relaxed);
+        s.owner.store(std::thread::id{}, std::memory_order_relaxed);
+
+        auto* c = chunks[index / SLOTS_PER_CHUNK].load(std::memory_order_acquire);
+        auto const mask = std::uint64_t{1} << (index % SLOTS_PER_CHUNK);
+        c->occupied.fetch_and(~mask, std::memory_order_release);
+    }
+
+    auto registry::at(usize_t const index) -> participant_slot&
+    {
+        auto* c = chunks[index / SLOTS_PER_CHUNK].load(std::memory_order_acquire);
+        return *c->slots[index % SLOTS_PER_CHUNK];
+    }
+
+    auto registry::find_straggler(epoch const& e) const -> straggler
+    {
+        auto found = straggler{NONE, epoch{}, std::thread::id{}};
+        for_each_straggler(e, [&found](straggler const& s)
+        {
+            found = s;
+            return false;
+        });
+
+        return found;
+    }
+
+    auto registry::all_pinned_in(epoch const& e) const -> bool
+    {
+        return NONE == find_straggler(e).slot;
+    }
+
+    auto registry::capacity() const noexcept -> usize_t
+    {
+        return chunk_count.load(std::memory_order_relaxed)*SLOTS_PER_CHUNK;
+    }
+
+    auto registry::occupied() const noexcept -> usize_t
+    {
+        auto total = 0ul;
+        auto const count = chunk_count.load(std::memory_order_acquire);
+        for (auto i = 0ul; i < count; ++i)
+        {
+            auto const* c = chunks[i].load(std::memory_order_acquire);
+            total += __builtin_popcountl(c->occupied.load(std::memory_order_relaxed));
+        }
+
+        return total;
+    }
+}
@@ -0,0 +1,73 @@
+// stats.cpp
+
+#include <epic/stats.hpp>
+
+namespace epic
+{
+    namespace
+    {
+        // A metric in a snapshot, for rendering.
+        struct metric
+        {
+            char const*   name;
+            char const*   type;
+            char const*   help;
+            std::uint64_t value;
+        };
+
+        // Visits the metrics of a snapshot. Counters are skipped if
+        // statistics are not compiled in, rather than reported as zero.
+        template <typename Visit>
+        auto for_each_metric(collector_stats const& s, Visit&& visit) -> void
+        {
+            if (s.enabled)
+            {
+                visit(metric{"pins_total",               "counter", "Calls to pin(), including nested pins.",      s.pins});
+                visit(metric{"outermost_pins_total",     "counter", "Pins that pinned an unpinned participant.",   s.outermost_pins});
+                visit(metric{"advance_attempts_total",   "counter", "Attempts to advance the global epoch.",       s.advance_attempts});
+                visit(metric{"advances_total",           "counter", "Successful advances of the global epoch.",    s.advances});
+                visit(metric{"bags_pushed_total",        "counter", "Sealed bags pushed to the global queues.",    s.bags_pushed});
+                visit(metric{"bags_collected_total",     "counter", "Expired bags popped from the global queues.", s.bags_collected});
+                visit(metric{"deferreds_retired_total",  "counter", "Deferred functions retired.",                 s.deferreds_retired});
+                visit(metric{"deferreds_executed_total", "counter", "Deferred functions executed.",                s.deferreds_executed});
+            }
+
+            visit(metric{"pending_bags",      "gauge", "Sealed bags awaiting collection.",      s.pending_bags});
+            visit(metric{"global_epoch",      "gauge", "The current global epoch.",             s.global_epoch});
+            visit(metric{"participants",      "gauge", "Registered participants.",              s.participants});
+            visit(metric{"unreclaimed_bytes", "gauge", "Bytes deferred but not yet reclaimed.", s.unreclaimed_bytes});
+        }
+    }
+
+    auto collector_stats::to_json() const -> std::string
+    {
+        auto out = std::string{"{\"enabled\":"};
+        out += enabled ? "true" : "false";
+
+        for_each_metric(*this, [&out](metric const& m)
+        {
+            out += ",\"";
+            out += m.name;
+            out += "\":";
+            out += std::to_string(m.value);
+        });
+
+        out += "}";
+        return out;
+    }
+
+    auto collector_stats::to_prometheus(std::string const& prefix) const -> std::string
+    {
+        auto out = std::string{};
+        for_each_metric(*this, [&](metric const& m)
+        {
+            auto const name = prefix + "_" + m.name;
+
+            out += "# HELP " + name + " " + m.help + "\n";
+            out += "# TYPE " + name + " " + m.type + "\n";
+            out += name + " " + std::to_string(m.value) + "\n";
+        });
+
+        return out;
+    }
+}
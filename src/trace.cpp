@@ -0,0 +1,269 @@
+// trace.cpp
+
+#include <epic/trace.hpp>
+
+#include <mutex>
+#include <memory>
+#include <cstdio>
+#include <algorithm>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+namespace epic
+{
+    namespace
+    {
+        // The rings of all threads that have recorded an event.
+        struct ring_directory
+        {
+            std::mutex lock;
+            std::vector<std::unique_ptr<trace_ring>> rings;
+
+            // A reference point of both clocks, to convert ticks.
+            std::uint64_t const origin_ticks;
+            std::chrono::steady_clock::time_point const origin_time;
+
+            ring_directory()
+                : lock{}
+                , rings{}
+                , origin_ticks{trace_clock()}
+                , origin_time{std::chrono::steady_clock::now()}
+            {}
+
+            // Never destroyed, so that the destructors of other static
+            // objects, such as the default collector, can still trace.
+            static auto instance() -> ring_directory&
+            {
+                static auto* const directory = new ring_directory{};
+                return *directory;
+            }
+        };
+
+        // The calling thread's ring. Both are trivially destructible, so
+        // they remain usable while the thread's other thread-local objects
+        // are being destroyed.
+        thread_local trace_ring* current_ring = nullptr;
+        thread_local bool ring_torn_down = false;
+
+        // Detaches the calling thread's ring when the thread exits. From
+        // then on clear_trace() may free the ring, so it is forgotten and
+        // later events of this thread are dropped.
+        struct ring_owner
+        {
+            bool armed = false;
+
+            ~ring_owner()
+            {
+                auto* const ring = current_ring;
+                current_ring   = nullptr;
+                ring_torn_down = true;
+
+                if (nullptr != ring)
+                {
+                    ring->detach();
+                }
+            }
+        };
+
+        thread_local ring_owner current_owner{};
+
+        auto append_event(std::string& out, trace_record const& r,
+            double const ns_per_tick, std::uint64_t const origin,
+            long const pid, std::uint64_t const tid) -> void
+        {
+            // Chrome trace timestamps are in (fractional) microseconds.
+            auto const to_us = [=](std::uint64_t const ticks)
+            {
+                return static_cast<double>(ticks)*ns_per_tick/1000.0;
+            };
+
+            auto const ts = to_us(r.timestamp > origin ? r.timestamp - origin : 0);
+
+            char buffer[256];
+            switch (r.kind)
+            {
+            case trace_kind::pin:
+                std::snprintf(buffer, sizeof(buffer),
+                    "{\"name\":\"pinned\",\"cat\":\"epic\",\"ph\":\"B\",\"ts\":%.3f,"
+                    "\"pid\":%ld,\"tid\":%lu,\"args\":{\"epoch\":%lu}}",
+                    ts, pid, tid, r.arg);
+                break;
+            case trace_kind::unpin:
+                std::snprintf(buffer, sizeof(buffer),
+                    "{\"name\":\"pinned\",\"cat\":\"epic\",\"ph\":\"E\",\"ts\":%.3f,"
+                    "\"pid\":%ld,\"tid\":%lu}",
+                    ts, pid, tid);
+                break;
+            case trace_kind::advance:
+                std::snprintf(buffer, sizeof(buffer),
+                    "{\"name\":\"advance\",\"cat\":\"epic\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+                    "\"pid\":%ld,\"tid\":%lu,\"args\":{\"epoch\":%lu}}",
+                    ts, pid, tid, r.arg);
+                break;
+            case trace_kind::seal:
+                std::snprintf(buffer, sizeof(buffer),
+                    "{\"name\":\"seal\",\"cat\":\"epic\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+                    "\"pid\":%ld,\"tid\":%lu,\"args\":{\"deferreds\":%lu}}",
+                    ts, pid, tid, r.arg);
+                break;
+            case trace_kind::collect:
+                std::snprintf(buffer, sizeof(buffer),
+                    "{\"name\":\"collect\",\"cat\":\"epic\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                    "\"pid\":%ld,\"tid\":%lu,\"args\":{\"deferreds\":%lu}}",
+                    ts, to_us(r.duration), pid, tid, r.arg);
+                break;
+            }
+
+            out += buffer;
+        }
+    }
+
+    trace_ring::trace_ring(std::uint64_t const tid_)
+        : head{0}
+        , cleared{0}
+        , detached{false}
+        , tid{tid_}
+        , entries(CAPACITY)
+    {}
+
+    auto trace_ring::current() noexcept -> trace_ring*
+    {
+        if (nullptr != current_ring || ring_torn_down)
+        {
+            return current_ring;
+        }
+
+        // Events are recorded from noexcept paths; if the ring cannot
+        // be allocated the event is dropped, and the next one retries.
+        try
+        {
+            auto& directory = ring_directory::instance();
+            auto ring = std::make_unique<trace_ring>(
+                static_cast<std::uint64_t>(::syscall(SYS_gettid)));
+
+            {
+                auto const lock = std::lock_guard{directory.lock};
+                directory.rings.push_back(std::move(ring));
+                current_ring = directory.rings.back().get();
+            }
+
+            // Constructs the owner, registering its destructor.
+            current_owner.armed = true;
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+
+        return current_ring;
+    }
+
+    auto trace_ring::snapshot(std::vector<trace_record>& out) const -> void
+    {
+        auto const end = head.load(std::memory_order_acquire);
+        auto const oldest = (end > CAPACITY) ? end - CAPACITY : 0;
+        auto const begin = std::max(oldest, cleared.load(std::memory_order_relaxed));
+
+        for (auto i = begin; i < end; ++i)
+        {
+            auto const& e = entries[i & (CAPACITY - 1)];
+
+            auto const before = e.seq.load(std::memory_order_acquire);
+            if (before != 2*i + 2)
+            {
+                // The entry has since been overwritten (or is being).
+                continue;
+            }
+
+            auto const timestamp = e.timestamp.load(std::memory_order_relaxed);
+            auto const duration  = e.duration.load(std::memory_order_relaxed);
+            auto const word      = e.word.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (e.seq.load(std::memory_order_relaxed) != before)
+            {
+                continue;
+            }
+
+            out.push_back(trace_record{timestamp, duration, word & ARG_MASK,
+                static_cast<trace_kind>(word >> 56)});
+        }
+    }
+
+    auto trace_ring::clear() noexcept -> void
+    {
+        cleared.store(head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    auto trace_ring::detach() noexcept -> void
+    {
+        detached.store(true, std::memory_order_release);
+    }
+
+    auto trace_ring::is_detached() const noexcept -> bool
+    {
+        return detached.load(std::memory_order_acquire);
+    }
+
+    auto trace_ring::get_tid() const noexcept -> std::uint64_t
+    {
+        return tid;
+    }
+
+    auto dump_trace() -> std::string
+    {
+        auto& directory = ring_directory::instance();
+        auto const lock = std::lock_guard{directory.lock};
+
+        // Calibrate ticks against the steady clock over the traced period.
+        auto const ticks   = trace_clock() - directory.origin_ticks;
+        auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - directory.origin_time).count();
+        auto const ns_per_tick = (0 != ticks && elapsed > 0)
+            ? static_cast<double>(elapsed)/static_cast<double>(ticks)
+            : 1.0;
+
+        auto const pid = static_cast<long>(::getpid());
+
+        auto out = std::string{"{\"traceEvents\":["};
+        auto first = true;
+
+        auto records = std::vector<trace_record>{};
+        for (auto const& ring : directory.rings)
+        {
+            records.clear();
+            ring->snapshot(records);
+
+            for (auto const& r : records)
+            {
+                if (!first)
+                {
+                    out += ",";
+                }
+
+                append_event(out, r, ns_per_tick, directory.origin_ticks, pid, ring->get_tid());
+                first = false;
+            }
+        }
+
+        out += "],\"displayTimeUnit\":\"ns\"}";
+        return out;
+    }
+
+    auto clear_trace() -> void
+    {
+        auto& directory = ring_directory::instance();
+        auto const lock = std::lock_guard{directory.lock};
+
+        // The rings of exited threads are no longer written; free them.
+        auto& rings = directory.rings;
+        rings.erase(std::remove_if(rings.begin(), rings.end(),
+            [](auto const& r) { return r->is_detached(); }), rings.end());
+
+        for (auto& r : rings)
+        {
+            r->clear();
+        }
+    }
+}
@@ -0,0 +1,93 @@
+// watchdog.cpp
+
+#include <epic/watchdog.hpp>
+#include <epic/registry.hpp>
+
+#include <algorithm>
+
+namespace epic
+{
+    watchdog::watchdog()
+        : threshold{0}
+        , last_advance{0}
+        , reported{epoch{}}
+        , lock{}
+        , callback{}
+    {}
+
+    auto watchdog::arm(std::chrono::nanoseconds const after, stall_callback cb) -> void
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        callback = std::move(cb);
+
+        // Start counting from now, not from the last advance seen
+        // while the watchdog was (possibly) disarmed.
+        last_advance.store(now(), std::memory_order_relaxed);
+        reported.store(epoch{}, std::memory_order_relaxed);
+        threshold.store(std::max<std::int64_t>(after.count(), 1), std::memory_order_release);
+    }
+
+    auto watchdog::disarm() -> void
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        threshold.store(0, std::memory_order_relaxed);
+        callback = nullptr;
+    }
+
+    auto watchdog::is_armed() const noexcept -> bool
+    {
+        return 0 != threshold.load(std::memory_order_relaxed);
+    }
+
+    auto watchdog::on_stall(registry& participants, straggler const& s, epoch const& global_epoch) -> void
+    {
+        auto const limit = threshold.load(std::memory_order_acquire);
+        if (0 == limit)
+        {
+            return;
+        }
+
+        auto const stalled_for = now() - last_advance.load(std::memory_order_relaxed);
+        if (stalled_for < limit)
+        {
+            return;
+        }
+
+        // If the participant unpinned since the scan, or its slot was
+        // reused, do not consume the report: a later scan still reports
+        // this epoch if another participant holds it back.
+        auto const& slot = participants.at(s.slot);
+        if (slot.local_epoch.load(std::memory_order_relaxed) != s.local_epoch
+         || slot.owner.load(std::memory_order_relaxed) != s.owner)
+        {
+            return;
+        }
+
+        // Report each stalled epoch once, from a single thread.
+        auto const prev = reported.load(std::memory_order_relaxed);
+        if (prev == global_epoch
+         || prev != reported.compare_and_swap(prev, global_epoch, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        auto const report = stall_report{
+            s.owner,
+            s.slot,
+            s.local_epoch.unpinned(),
+            global_epoch,
+            std::chrono::nanoseconds{stalled_for}};
+
+        std::lock_guard<std::mutex> guard{lock};
+        if (callback)
+        {
+            callback(report);
+        }
+    }
+
+    auto watchdog::now() noexcept -> std::int64_t
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
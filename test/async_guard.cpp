@@ -0,0 +1,171 @@
+// test/async_guard.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/atomic.hpp>
+#include <epic/global.hpp>
+#include <epic/default.hpp>
+#include <epic/async_guard.hpp>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#if defined(EPIC_COROUTINES)
+#include <coroutine>
+#endif
+
+namespace
+{
+#if defined(EPIC_COROUTINES)
+    // A coroutine type that starts eagerly and is never awaited.
+    struct task
+    {
+        struct promise_type
+        {
+            auto get_return_object() -> task { return {}; }
+            auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+            auto final_suspend() noexcept -> std::suspend_never { return {}; }
+            auto return_void() -> void {}
+            auto unhandled_exception() -> void { std::terminate(); }
+        };
+    };
+
+    // An awaiter that resumes the coroutine on a new thread.
+    struct resume_elsewhere
+    {
+        std::thread& resumer;
+
+        auto await_ready() -> bool { return false; }
+        auto await_suspend(std::coroutine_handle<> h) -> void
+        {
+            resumer = std::thread{[h]() { h.resume(); }};
+        }
+        auto await_resume() -> std::thread::id { return std::this_thread::get_id(); }
+    };
+
+    // The state shared by a coroutine and the test that starts it.
+    struct handoff
+    {
+        std::thread resumer{};
+        std::thread::id resumed_on{};
+        bool pinned_after{false};
+
+        std::mutex done{};
+        std::condition_variable finished{};
+        bool is_done{false};
+    };
+
+    // Suspends under an async_guard and records where it resumed.
+    // A parameter rather than a lambda capture, since the closure
+    // does not outlive the first suspension.
+    auto suspend_once(handoff& h) -> task
+    {
+        auto g = epic::async_guard{};
+        h.resumed_on   = co_await epic::unpinned(g, resume_elsewhere{h.resumer});
+        h.pinned_after = epic::default_handle().is_pinned();
+
+        auto const l = std::lock_guard{h.done};
+        h.is_done = true;
+        h.finished.notify_one();
+    }
+#endif
+}
+
+TEST_CASE("epic::async_guard")
+{
+    using namespace epic;
+
+    SECTION("unpins while suspended")
+    {
+        auto g = async_guard{};
+        REQUIRE(default_handle().is_pinned());
+        REQUIRE(g.generation() == 0);
+
+        g.suspend();
+        REQUIRE(g.is_suspended());
+        REQUIRE_FALSE(default_handle().is_pinned());
+
+        // a suspended guard does not hold back the epoch
+        auto& gl = *default_collector().instance;
+        auto const before = gl.try_advance();
+        REQUIRE(gl.try_advance() == before.successor());
+
+        g.resume();
+        REQUIRE(default_handle().is_pinned());
+        REQUIRE(g.generation() == 1);
+    }
+
+    SECTION("resumes on another thread")
+    {
+        auto g = async_guard{};
+        g.suspend();
+
+        auto pinned_there = false;
+        auto t = std::thread{[&]()
+        {
+            g.resume();
+            pinned_there = default_handle().is_pinned();
+            g.suspend();
+        }};
+        t.join();
+
+        REQUIRE(pinned_there);
+        REQUIRE_FALSE(default_handle().is_pinned());
+
+        g.resume();
+        REQUIRE(default_handle().is_pinned());
+    }
+
+    SECTION("loads through atomic<T>")
+    {
+        auto a = atomic<int>::make(7);
+        auto g = async_guard{};
+        REQUIRE(*a.load(std::memory_order_acquire, g) == 7);
+
+        g.defer_destroy(a.swap(shared<int>::null(), std::memory_order_acq_rel, g.get()).clone());
+    }
+
+    SECTION("lookups are repeated after a suspension")
+    {
+        auto a = atomic<int>::make(1);
+        auto lookups = 0;
+        auto find = async_lookup{[&](guard& pg)
+        {
+            ++lookups;
+            return a.load(std::memory_order_acquire, pg);
+        }};
+
+        auto g = async_guard{};
+        REQUIRE(*find(g) == 1);
+        REQUIRE(*find(g) == 1);
+        REQUIRE(lookups == 1);
+
+        g.suspend();
+        REQUIRE(find.is_stale(g));
+        g.resume();
+
+        REQUIRE(*find(g) == 1);
+        REQUIRE(lookups == 2);
+
+        g.defer_destroy(a.swap(shared<int>::null(), std::memory_order_acq_rel, g.get()).clone());
+    }
+
+#if defined(EPIC_COROUTINES)
+    SECTION("co_await through unpinned() moves the pin to the resuming thread")
+    {
+        auto h = handoff{};
+        suspend_once(h);
+
+        REQUIRE_FALSE(default_handle().is_pinned());
+
+        auto l = std::unique_lock{h.done};
+        h.finished.wait(l, [&]() { return h.is_done; });
+        l.unlock();
+        h.resumer.join();
+
+        REQUIRE(h.resumed_on != std::this_thread::get_id());
+        REQUIRE(h.pinned_after);
+    }
+#endif
+}
@@ -0,0 +1,165 @@
+// test/atomic_wide.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/guard.hpp>
+#include <epic/hp_guard.hpp>
+#include <epic/default.hpp>
+#include <epic/hp_collector.hpp>
+#include <epic/atomic_wide.hpp>
+
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+static_assert(epic::atomic_wide<int>::is_always_lock_free);
+#endif
+
+TEST_CASE("epic::atomic_wide")
+{
+    using namespace epic;
+
+    SECTION("is double-width and 16-byte aligned")
+    {
+        REQUIRE(sizeof(atomic_wide<int>) == 2*sizeof(usize_t));
+        REQUIRE(alignof(atomic_wide<int>) == 2*sizeof(usize_t));
+
+        auto a = atomic_wide<int>::null();
+        REQUIRE(a.is_null());
+        REQUIRE(a.is_lock_free() == atomic_wide<int>::is_always_lock_free);
+    }
+
+    SECTION("loads the pointer together with its version")
+    {
+        auto a = make_atomic_wide<int>(5);
+        auto g = guard{};
+
+        auto v = a.load(std::memory_order_acquire, g);
+        REQUIRE(*v.ptr == 5);
+        REQUIRE(v.version == 0);
+
+        a.store(make_owned<int>(17), std::memory_order_release);
+        auto w = a.load(std::memory_order_acquire, g);
+        REQUIRE(*w.ptr == 17);
+        REQUIRE(w.version == 1);
+        REQUIRE(a.version(std::memory_order_relaxed) == 1);
+
+        pointable<int>::drop(v.ptr.into_usize());
+        a.into_owned();
+    }
+
+    SECTION("compare_and_set() compares the version as well as the pointer")
+    {
+        auto a = make_atomic_wide<int>(1);
+        auto g = guard{};
+
+        auto stale = a.load(std::memory_order_acquire, g);
+        auto first = stale.ptr;
+
+        // remove the pointer and reinstall it: the classic ABA
+        auto removed = a.swap(shared<int>::null(), std::memory_order_acq_rel, g);
+        REQUIRE(removed.version == 0);
+        a.store(first.clone(), std::memory_order_release);
+
+        REQUIRE_FALSE(a.compare_and_set(stale, shared<int>::null(), std::memory_order_acq_rel, g));
+
+        auto fresh = a.load(std::memory_order_acquire, g);
+        REQUIRE(fresh.version == 2);
+        auto const next = a.compare_and_set(fresh, make_owned<int>(2), std::memory_order_acq_rel, g);
+        REQUIRE(next);
+        REQUIRE(next->version == 3);
+
+        pointable<int>::drop(first.clone().into_usize());
+        a.into_owned();
+    }
+
+    SECTION("a failed compare_and_set() leaves the owned pointer with the caller")
+    {
+        auto a = make_atomic_wide<int>(1);
+        auto g = guard{};
+
+        auto stale = a.load(std::memory_order_acquire, g);
+        a.fetch_add_version(1, std::memory_order_relaxed);
+
+        auto next = make_owned<int>(2);
+        REQUIRE_FALSE(a.compare_and_set(stale, std::move(next), std::memory_order_acq_rel, g));
+        REQUIRE(*next == 2);
+
+        // the same node may be used to retry
+        auto fresh = a.load(std::memory_order_acquire, g);
+        REQUIRE(a.compare_and_set_weak(fresh, std::move(next), std::memory_order_acq_rel, g));
+        REQUIRE(*a.load(std::memory_order_acquire, g).ptr == 2);
+
+        pointable<int>::drop(fresh.ptr.into_usize());
+        a.into_owned();
+    }
+
+    SECTION("updates the tag without changing the version")
+    {
+        auto a = make_atomic_wide<long>(3);
+        auto g = guard{};
+
+        a.fetch_or(1, std::memory_order_acq_rel, g);
+        auto v = a.load(std::memory_order_acquire, g);
+        REQUIRE(v.ptr.tag() == 1);
+        REQUIRE(v.version == 0);
+
+        a.fetch_and(0, std::memory_order_acq_rel, g);
+        REQUIRE(a.fetch_add_version(1, std::memory_order_relaxed) == 0);
+        REQUIRE(a.load(std::memory_order_acquire, g).version == 1);
+
+        a.into_owned();
+    }
+
+    SECTION("protects the loaded pointer under an hp_guard")
+    {
+        auto c = hp_collector{};
+        auto const h = c.register_handle();
+        auto g = h.pin();
+
+        auto a = make_atomic_wide<int>(4);
+        auto v = a.load(std::memory_order_acquire, g);
+
+        auto old = a.swap(shared<int>::null(), std::memory_order_acq_rel, g);
+        g.defer_destroy(old.ptr.clone());
+        g.flush();
+
+        REQUIRE(h.pending() == 1);
+        REQUIRE(*v.ptr == 4);
+    }
+
+    SECTION("counts every successful compare_and_set under contention")
+    {
+        constexpr static auto const THREADS = 4ul;
+        constexpr static auto const OPS     = 1000ul;
+
+        auto a = atomic_wide<int>::null();
+
+        auto threads = std::vector<std::thread>{};
+        for (auto i = 0ul; i < THREADS; ++i)
+        {
+            threads.emplace_back([&]()
+            {
+                auto g = default_handle().pin();
+                for (auto n = 0ul; n < OPS; ++n)
+                {
+                    for (;;)
+                    {
+                        auto current = a.load(std::memory_order_acquire, g);
+                        if (a.compare_and_set(current, shared<int>::null(), std::memory_order_acq_rel, g))
+                        {
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        REQUIRE(a.version(std::memory_order_relaxed) == THREADS*OPS);
+    }
+}
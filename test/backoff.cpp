@@ -0,0 +1,34 @@
+// test/backoff.cpp
+
+#include <catch2/catch.hpp>
+#include <epic/backoff.hpp>
+
+TEST_CASE("epic::backoff")
+{
+    using namespace epic;
+
+    SECTION("completes after snoozing for a while")
+    {
+        auto b = backoff{};
+        REQUIRE_FALSE(b.is_completed());
+
+        while (!b.is_completed())
+        {
+            b.snooze();
+        }
+
+        b.reset();
+        REQUIRE_FALSE(b.is_completed());
+    }
+
+    SECTION("spinning alone never completes")
+    {
+        auto b = backoff{};
+        for (auto i = 0; i < 32; ++i)
+        {
+            b.spin();
+        }
+
+        REQUIRE_FALSE(b.is_completed());
+    }
+}
@@ -0,0 +1,135 @@
+// test/backpressure.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/global.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("epic::backpressure")
+{
+    using namespace epic;
+    using namespace std::chrono_literals;
+
+    // The number of defers after which a participant has certainly
+    // sealed (at least) two bags, reaching a cap of one bag.
+    constexpr static auto const ENOUGH = 4*MAX_OBJECTS;
+
+    SECTION("the garbage cap is unbounded by default")
+    {
+        auto c = collector{};
+        REQUIRE(c.get_garbage_cap() == 0);
+        REQUIRE(c.get_backpressure() == backpressure::block);
+    }
+
+    SECTION("rejects deferred functions at the cap and returns ownership")
+    {
+        auto c = collector{};
+        c.set_garbage_cap(1, backpressure::reject);
+
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        std::atomic_ulong x{};
+        {
+            // the stalled reader keeps the writer's bags from expiring
+            auto rg = reader.pin();
+            auto wg = writer.pin();
+
+            auto status = defer_status::ok;
+            for (auto i = 0ul; i < ENOUGH && defer_status::ok == status; ++i)
+            {
+                status = wg.defer([&x](){ x.fetch_add(1); });
+            }
+
+            REQUIRE(status == defer_status::would_exceed);
+
+            auto d = deferred{[&x](){ x.fetch_add(100); }};
+            REQUIRE(wg.defer(std::move(d)) == defer_status::would_exceed);
+
+            // the caller still owns the rejected function
+            d.call();
+            REQUIRE(x.load() == 100);
+        }
+    }
+
+    SECTION("forces an advance attempt at the cap but always defers")
+    {
+        auto c = collector{};
+        c.set_garbage_cap(1, backpressure::advance);
+
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        auto rg = reader.pin();
+        auto wg = writer.pin();
+
+        for (auto i = 0ul; i < ENOUGH; ++i)
+        {
+            REQUIRE(wg.defer([](){}) == defer_status::ok);
+        }
+
+        REQUIRE(c.instance->pending() > 1);
+    }
+
+    SECTION("reader-only handles at the cap never collect inline")
+    {
+        auto c = collector{};
+        c.set_garbage_cap(1, backpressure::advance);
+
+        auto const h = c.register_reader();
+
+        std::atomic_ulong x{};
+        for (auto i = 0ul; i < ENOUGH; ++i)
+        {
+            auto g = h.pin();
+            REQUIRE(g.defer([&x](){ x.fetch_add(1); }) == defer_status::ok);
+        }
+
+        REQUIRE(x.load() == 0);
+    }
+
+    SECTION("blocks at the cap until the epoch advances")
+    {
+        auto c = collector{};
+        c.set_garbage_cap(1, backpressure::block);
+
+        std::atomic_bool pinned{false};
+
+        // the reader pins in the current epoch, which is then advanced
+        // once; the writer cannot get another advance until it unpins
+        auto reader = std::thread{[&c, &pinned]()
+        {
+            auto const h = c.register_handle();
+            auto g = h.pin();
+            pinned.store(true);
+            std::this_thread::sleep_for(50ms);
+        }};
+
+        while (!pinned.load())
+        {
+            std::this_thread::yield();
+        }
+
+        c.instance->try_advance();
+
+        auto const writer = c.register_handle();
+        auto const start  = std::chrono::steady_clock::now();
+        {
+            auto wg = writer.pin();
+            for (auto i = 0ul; i < ENOUGH; ++i)
+            {
+                REQUIRE(wg.defer([](){}) == defer_status::ok);
+            }
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        reader.join();
+
+        REQUIRE(elapsed >= 25ms);
+    }
+}
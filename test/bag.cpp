@@ -86,4 +86,65 @@ TEST_CASE("epic::bag")
 
         REQUIRE_THROWS_AS(b->try_push(deferred{[&x](){ ++x; }}), std::runtime_error);
     }
+
+    SECTION("method reset() executes stored functions and unseals the bag")
+    {
+        unsigned long x{};
+
+        auto b = std::make_unique<bag>();
+
+        b->try_push(deferred{[&x](){ ++x; }});
+        b->try_push(deferred{[&x](){ ++x; }});
+        b->seal(epoch::with_value(16));
+
+        b->reset();
+
+        REQUIRE(x == 2);
+        REQUIRE(b->is_empty());
+
+        // the bag may be reused, and does not re-run old functions
+        auto r = b->try_push(deferred{[&x](){ ++x; }});
+        REQUIRE_FALSE(r.has_value());
+
+        b.reset();
+        REQUIRE(x == 3);
+    }
+
+    SECTION("method size_in_bytes() sums the bytes of stored functions")
+    {
+        auto b = std::make_unique<bag>();
+        REQUIRE(b->size_in_bytes() == 0);
+
+        b->try_push(deferred{[](){}}, 64);
+        b->try_push(deferred{[](){}});
+        b->try_push(deferred{[](){}}, 1024);
+        REQUIRE(b->size_in_bytes() == 1088);
+
+        b->reset();
+        REQUIRE(b->size_in_bytes() == 0);
+    }
+
+    SECTION("method push_many() moves as many functions as fit")
+    {
+        unsigned long x{};
+
+        auto fns = std::array<deferred, MAX_OBJECTS + 2>{};
+        for (auto& f : fns)
+        {
+            f = deferred{[&x](){ ++x; }};
+        }
+
+        auto b = std::make_unique<bag>();
+        REQUIRE(b->push_many(fns.data(), 2, 100) == 2);
+        REQUIRE(b->size_in_bytes() == 100);
+
+        // only the functions that fit are attributed their bytes
+        REQUIRE(b->push_many(fns.data() + 2, MAX_OBJECTS, MAX_OBJECTS*10) == MAX_OBJECTS - 2);
+        REQUIRE(b->size_in_bytes() == 100 + (MAX_OBJECTS - 2)*10);
+        REQUIRE(b->is_full());
+        REQUIRE(b->push_many(fns.data() + MAX_OBJECTS, 2) == 0);
+
+        b.reset();
+        REQUIRE(x == MAX_OBJECTS);
+    }
 }
\ No newline at end of file
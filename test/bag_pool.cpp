@@ -0,0 +1,60 @@
+// test/bag_pool.cpp
+
+#include <catch2/catch.hpp>
+#include <epic/bag_pool.hpp>
+
+#include <memory>
+
+TEST_CASE("epic::bag_pool")
+{
+    using namespace epic;
+
+    SECTION("is empty on construction")
+    {
+        auto p = bag_pool{};
+        REQUIRE(p.size() == 0);
+        REQUIRE(p.take() == nullptr);
+    }
+
+    SECTION("returns the bags that were put into it")
+    {
+        auto p = bag_pool{};
+
+        auto b = std::make_unique<bag>();
+        auto* raw = b.get();
+
+        REQUIRE(p.try_put(std::move(b)) == nullptr);
+        REQUIRE(p.size() == 1);
+
+        auto taken = p.take();
+        REQUIRE(taken.get() == raw);
+        REQUIRE(p.size() == 0);
+    }
+
+    SECTION("hands back bags once it is full")
+    {
+        auto p = bag_pool{2};
+
+        REQUIRE(p.try_put(std::make_unique<bag>()) == nullptr);
+        REQUIRE(p.try_put(std::make_unique<bag>()) == nullptr);
+        REQUIRE(p.is_full());
+
+        auto b = std::make_unique<bag>();
+        auto* raw = b.get();
+
+        auto rejected = p.try_put(std::move(b));
+        REQUIRE(rejected.get() == raw);
+        REQUIRE(p.size() == 2);
+    }
+
+    SECTION("frees all of its bags on clear()")
+    {
+        auto p = bag_pool{};
+
+        p.try_put(std::make_unique<bag>());
+        p.try_put(std::make_unique<bag>());
+        p.clear();
+
+        REQUIRE(p.size() == 0);
+    }
+}
@@ -0,0 +1,89 @@
+// test/default.cpp
+
+#include <catch2/catch.hpp>
+#include <epic/default.hpp>
+
+#include <atomic>
+#include <thread>
+
+// Repeatedly pin and flush the current thread until
+// `done()` holds, or the attempt budget is exhausted.
+template <typename Predicate>
+static auto flush_until(Predicate done) -> bool
+{
+    for (auto i = 0; i < 1024 && !done(); ++i)
+    {
+        auto g = epic::pin();
+        g.flush();
+    }
+
+    return done();
+}
+
+TEST_CASE("epic::pin()")
+{
+    using namespace epic;
+
+    SECTION("pins the current thread in the default collector")
+    {
+        REQUIRE_FALSE(is_pinned());
+
+        {
+            auto g = pin();
+            REQUIRE_FALSE(g.is_dummy());
+            REQUIRE(is_pinned());
+        }
+
+        REQUIRE_FALSE(is_pinned());
+    }
+
+    SECTION("is reentrant")
+    {
+        auto outer = pin();
+
+        {
+            auto inner = pin();
+            REQUIRE(is_pinned());
+        }
+
+        REQUIRE(is_pinned());
+    }
+
+    SECTION("registers the current thread exactly once")
+    {
+        auto const& h = default_handle();
+        auto g = pin();
+
+        REQUIRE(h.is_pinned());
+        REQUIRE(&h == &default_handle());
+    }
+
+    SECTION("eventually executes deferred functions")
+    {
+        std::atomic_ulong x{};
+
+        {
+            auto g = pin();
+            g.defer([&x](){ x.fetch_add(1); });
+        }
+
+        REQUIRE(flush_until([&x](){ return x.load() == 1; }));
+    }
+
+    SECTION("finalizes a thread's participant on thread exit")
+    {
+        std::atomic_ulong x{};
+
+        std::thread t{[&x]()
+        {
+            auto g = pin();
+            REQUIRE(is_pinned());
+            g.defer([&x](){ x.fetch_add(1); });
+        }};
+
+        t.join();
+
+        // The exiting thread flushed its bag to the global queue.
+        REQUIRE(flush_until([&x](){ return x.load() == 1; }));
+    }
+}
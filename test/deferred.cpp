@@ -1,9 +1,11 @@
 // test/deferred.cpp
 
-#define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 #include <epic/deferred.hpp>
 
+#include <array>
+#include <memory>
+
 TEST_CASE("epic::deferred")
 {
     using namespace epic;
@@ -42,4 +44,59 @@ TEST_CASE("epic::deferred")
         REQUIRE(x == 1);
         REQUIRE(y == 1);
     }
+
+    SECTION("stores small captures inline and boxes large ones")
+    {
+        unsigned long x{};
+        auto small = [&x](){ ++x; };
+        auto large = [&x, pad = std::array<unsigned long, 8>{}](){ x += pad.size(); };
+
+        REQUIRE(deferred::fits_inline<decltype(small)>());
+        REQUIRE_FALSE(deferred::fits_inline<decltype(large)>());
+
+        deferred s{small};
+        deferred l{large};
+
+        s.call();
+        l.call();
+
+        REQUIRE(x == 9);
+    }
+
+    SECTION("invokes the stored function at most once")
+    {
+        unsigned long x{};
+
+        deferred d{[&x](){ ++x; }};
+
+        d.call();
+        d.call();
+
+        REQUIRE(x == 1);
+    }
+
+    SECTION("destroys captures of a function that is never invoked")
+    {
+        auto p = std::make_shared<int>(5);
+
+        {
+            deferred d{[p](){}};
+            auto moved = std::move(d);
+            REQUIRE(p.use_count() == 2);
+        }
+
+        REQUIRE(p.use_count() == 1);
+    }
+
+    SECTION("supports the function-pointer fast path for destructors")
+    {
+        auto const raw = pointable<std::shared_ptr<int>>::init(std::make_shared<int>(5));
+        auto const observer = pointable<std::shared_ptr<int>>::deref(raw);
+
+        auto d = deferred::make_destroy<std::shared_ptr<int>>(raw);
+        REQUIRE(observer.use_count() == 2);
+
+        d.call();
+        REQUIRE(observer.use_count() == 1);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+// test/executor.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/bag.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+TEST_CASE("epic::executor")
+{
+    using namespace epic;
+
+    SECTION("may be started and stopped via the collector")
+    {
+        auto c = collector{};
+        REQUIRE(c.worker_count() == 0);
+
+        REQUIRE_FALSE(c.start_workers(0));
+
+        REQUIRE(c.start_workers(2));
+        REQUIRE(c.worker_count() == 2);
+        REQUIRE_FALSE(c.start_workers(2));
+
+        REQUIRE(c.stop_workers());
+        REQUIRE(c.worker_count() == 0);
+        REQUIRE_FALSE(c.stop_workers());
+    }
+
+    SECTION("executes collected bags on the worker threads")
+    {
+        constexpr static auto const N = 64*MAX_OBJECTS;
+
+        std::atomic_ulong x{};
+        std::mutex m{};
+        auto ids = std::unordered_set<std::thread::id>{};
+
+        auto c = collector{};
+        REQUIRE(c.start_workers(2));
+
+        auto const h = c.register_handle();
+        for (auto i = 0ul; i < N; ++i)
+        {
+            auto g = h.pin();
+            g.defer([&]()
+            { 
+                x.fetch_add(1); 
+                std::lock_guard<std::mutex> lk{m};
+                ids.insert(std::this_thread::get_id());
+            });
+        }
+
+        for (auto i = 0; i < 8; ++i)
+        {
+            h.pin().flush();
+        }
+
+        // stopping the pool waits for the bags that were handed to it
+        REQUIRE(c.stop_workers());
+
+        REQUIRE(x.load() > 0);
+        REQUIRE(ids.count(std::this_thread::get_id()) == 0);
+    }
+
+    SECTION("drains the remaining garbage when the collector is destroyed")
+    {
+        constexpr static auto const N = 16*MAX_OBJECTS;
+
+        std::atomic_ulong x{};
+        {
+            auto c = collector{};
+            REQUIRE(c.start_workers(4));
+
+            auto const h = c.register_handle();
+            auto g = h.pin();
+            for (auto i = 0ul; i < N; ++i)
+            {
+                g.defer([&x](){ x.fetch_add(1); });
+            }
+        }
+
+        REQUIRE(x.load() == N);
+    }
+}
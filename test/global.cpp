@@ -0,0 +1,138 @@
+// test/global.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/global.hpp>
+
+#include <memory>
+
+TEST_CASE("epic::global")
+{
+    using namespace epic;
+
+    SECTION("collects more bags per step as the backlog grows")
+    {
+        REQUIRE(global::collect_steps(0) == global::COLLECT_STEPS);
+        REQUIRE(global::collect_steps(16) == global::COLLECT_STEPS);
+        REQUIRE(global::collect_steps(128) == 32);
+        REQUIRE(global::collect_steps(1 << 20) == global::MAX_COLLECT_STEPS);
+    }
+
+    SECTION("rounds the number of shards up to a power of two")
+    {
+        REQUIRE(global{0}.shard_count == 1);
+        REQUIRE(global{3}.shard_count == 4);
+        REQUIRE(global{1 << 20}.shard_count == global::MAX_SHARDS);
+    }
+
+    SECTION("does not attempt to advance the epoch when no bags are pending")
+    {
+        auto g = global{4};
+
+        auto const before = g.global_epoch.load(std::memory_order_relaxed);
+
+        REQUIRE(g.pending() == 0);
+        REQUIRE(g.collect(0, nullptr) == 0);
+
+        auto const after = g.global_epoch.load(std::memory_order_relaxed);
+        REQUIRE(before == after);
+    }
+
+    SECTION("tracks the number of pending bags per shard")
+    {
+        auto g = global{4};
+
+        g.push_bag(std::make_unique<bag>(), 1);
+        g.push_bag(std::make_unique<bag>(), 1);
+
+        REQUIRE(g.pending() == 2);
+        REQUIRE(g.pending(1) == 2);
+
+        // a shard without bags still sees that there is a backlog elsewhere
+        REQUIRE(g.pending(2) == 1);
+    }
+
+    SECTION("steals expired bags from other shards")
+    {
+        auto g = global{4};
+
+        g.push_bag(std::make_unique<bag>(), 1);
+        g.push_bag(std::make_unique<bag>(), 3);
+
+        // no participants are pinned, so each collection advances the
+        // epoch by one step; bags expire two epochs after they are sealed
+        for (auto i = 0; i < 4 && g.pending() > 0; ++i)
+        {
+            g.collect(0, nullptr);
+        }
+
+        REQUIRE(g.pending() == 0);
+        REQUIRE(g.pending(0) == 0);
+    }
+
+    SECTION("recycles collected bags instead of freeing them")
+    {
+        auto g = global{1};
+        auto p = bag_pool{};
+
+        auto b = g.acquire_bag(&p);
+        auto* raw = b.get();
+
+        g.push_bag(std::move(b), 0);
+        for (auto i = 0; i < 4 && g.pending() > 0; ++i)
+        {
+            g.collect(0, &p);
+        }
+
+        REQUIRE(p.size() == 1);
+
+        // the next bag comes from the pool, not the allocator
+        auto recycled = g.acquire_bag(&p);
+        REQUIRE(recycled.get() == raw);
+        REQUIRE(recycled->is_empty());
+    }
+
+    SECTION("frees bags from the shared pool when trimmed")
+    {
+        auto g = global{1};
+
+        g.recycle_bag(std::make_unique<bag>(), nullptr);
+        g.recycle_bag(std::make_unique<bag>(), nullptr);
+        REQUIRE(g.free_count.load() == 2);
+
+        REQUIRE(g.trim() == 2);
+        REQUIRE(g.free_count.load() == 0);
+    }
+
+    SECTION("reports crossing the byte threshold exactly once")
+    {
+        auto g = global{1};
+        g.byte_threshold.store(1000);
+
+        REQUIRE_FALSE(g.account_bytes(600));
+        REQUIRE_FALSE(g.is_under_pressure());
+
+        REQUIRE(g.account_bytes(600));
+        REQUIRE(g.is_under_pressure());
+
+        REQUIRE_FALSE(g.account_bytes(600));
+        REQUIRE(g.unreclaimed() == 1800);
+    }
+
+    SECTION("releases the accounted bytes of collected bags")
+    {
+        auto g = global{1};
+
+        auto b = std::make_unique<bag>();
+        b->try_push(deferred{[](){}}, 4096);
+        g.account_bytes(4096);
+        g.push_bag(std::move(b), 0);
+
+        for (auto i = 0; i < 4 && g.pending() > 0; ++i)
+        {
+            g.collect(0, nullptr);
+        }
+
+        REQUIRE(g.unreclaimed() == 0);
+    }
+}
\ No newline at end of file
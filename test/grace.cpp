@@ -0,0 +1,205 @@
+// test/grace.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/guard.hpp>
+#include <epic/global.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
+namespace
+{
+    // Holds a guard of `reader` for a while, and checks that `sync` does
+    // not return before the guard is dropped.
+    template <typename Sync>
+    auto check_waits_for_reader(epic::collector& c, Sync&& sync) -> void
+    {
+        auto const reader = c.register_handle();
+        auto returned = std::atomic_bool{false};
+
+        auto g = reader.pin();
+        auto t = std::thread{[&]
+        {
+            sync();
+            returned.store(true);
+        }};
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        REQUIRE_FALSE(returned.load());
+
+        g = epic::guard{};
+        t.join();
+        REQUIRE(returned.load());
+    }
+}
+
+TEST_CASE("epic::collector::synchronize()")
+{
+    using namespace epic;
+
+    SECTION("returns without readers")
+    {
+        auto c = collector{};
+        c.synchronize();
+        c.synchronize_expedited();
+
+        auto const h = c.register_handle();
+        c.synchronize();
+    }
+
+    SECTION("waits for the readers pinned when it is called")
+    {
+        auto c = collector{};
+        check_waits_for_reader(c, [&c]() { c.synchronize(); });
+    }
+
+    SECTION("the expedited variant waits for the same readers")
+    {
+        auto c = collector{};
+        check_waits_for_reader(c, [&c]() { c.synchronize_expedited(); });
+    }
+
+    SECTION("readers that pin later are not waited for")
+    {
+        auto c = collector{};
+        auto const reader = c.register_handle();
+
+        auto g = reader.pin();
+        auto t = std::thread{[&c]() { c.synchronize_expedited(); }};
+
+        // repinning keeps a reader, but not the one synchronize() waits for
+        for (auto i = 0; i < 10; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            g.repin();
+        }
+
+        t.join();
+    }
+
+    SECTION("concurrent callers share grace periods")
+    {
+        constexpr static auto const CALLERS = 8;
+
+        auto c = collector{};
+        auto const reader = c.register_handle();
+        auto const before = c.instance->global_epoch.load(std::memory_order_relaxed);
+
+        auto g = reader.pin();
+        auto callers = std::vector<std::thread>{};
+        for (auto i = 0; i < CALLERS; ++i)
+        {
+            callers.emplace_back([&c]() { c.synchronize_expedited(); });
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        g = guard{};
+
+        for (auto& t : callers)
+        {
+            t.join();
+        }
+
+        // callers started in the reader's epoch or the one after it
+        auto const after = c.instance->global_epoch.load(std::memory_order_relaxed);
+        REQUIRE(after.wrapping_sub(before) <= 3);
+    }
+
+    SECTION("waits for readers under scheme::hyaline")
+    {
+        auto c = collector{scheme::hyaline};
+        check_waits_for_reader(c, [&c]() { c.synchronize(); });
+    }
+}
+
+TEST_CASE("epic::collector::notify_after_grace_period()")
+{
+    using namespace epic;
+
+    // Returns `true` if `fd` becomes readable within `timeout_ms`.
+    auto const readable = [](int fd, int timeout_ms) -> bool
+    {
+        auto p = pollfd{fd, POLLIN, 0};
+        return 1 == ::poll(&p, 1, timeout_ms);
+    };
+
+    SECTION("the callback runs once the readers have unpinned")
+    {
+        auto c = collector{};
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        auto x = std::atomic_int{0};
+        auto g = reader.pin();
+        c.notify_after_grace_period([&x]() { x.fetch_add(1); });
+
+        for (auto i = 0; i < 4; ++i)
+        {
+            writer.pin().flush();
+        }
+        REQUIRE(x.load() == 0);
+
+        g = guard{};
+        for (auto i = 0; i < 4; ++i)
+        {
+            writer.pin().flush();
+        }
+        REQUIRE(x.load() == 1);
+    }
+
+    SECTION("the eventfd counts completed grace periods")
+    {
+        auto c = collector{};
+        auto const h = c.register_handle();
+
+        auto const fd = c.grace_period_fd();
+        REQUIRE(fd >= 0);
+        REQUIRE(c.grace_period_fd() == fd);
+        REQUIRE_FALSE(readable(fd, 0));
+
+        REQUIRE(c.request_grace_period());
+        REQUIRE(c.request_grace_period());
+        for (auto i = 0; i < 4; ++i)
+        {
+            h.pin().flush();
+        }
+
+        REQUIRE(readable(fd, 0));
+        auto count = std::uint64_t{0};
+        REQUIRE(::read(fd, &count, sizeof(count)) == sizeof(count));
+        REQUIRE(count == 2);
+        REQUIRE_FALSE(readable(fd, 0));
+    }
+
+    SECTION("the background reclaimer completes requests of idle callers")
+    {
+        auto c = collector{};
+        auto const h = c.register_handle();
+        c.start_reclaimer(std::chrono::milliseconds{1});
+
+        REQUIRE(c.request_grace_period());
+        REQUIRE(readable(c.grace_period_fd(), 5000));
+    }
+
+    SECTION("requests complete on unpin under scheme::hyaline")
+    {
+        auto c = collector{scheme::hyaline};
+        auto const reader = c.register_handle();
+
+        auto g = reader.pin();
+        REQUIRE(c.request_grace_period());
+        REQUIRE_FALSE(readable(c.grace_period_fd(), 0));
+
+        g = guard{};
+        REQUIRE(readable(c.grace_period_fd(), 0));
+    }
+}
@@ -1,13 +1,151 @@
 // test/guard.cpp
 
 #include <catch2/catch.hpp>
+#include <epic/bag.hpp>
 #include <epic/guard.hpp>
+#include <epic/global.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <vector>
+#include <iterator>
+
+namespace
+{
+    // A node that counts how many of its kind have been destroyed.
+    struct counted_node
+    {
+        static inline unsigned long destroyed = 0;
+
+        counted_node* next;
+
+        explicit counted_node(counted_node* next_ = nullptr) 
+            : next{next_} {}
+
+        ~counted_node()
+        {
+            ++destroyed;
+        }
+    };
+}
 
 TEST_CASE("epic::guard")
 {
+    using namespace epic;
+
     SECTION("may be default constructed to produce a dummy guard")
     {
         auto g = epic::guard{};
         REQUIRE(g.is_dummy());
     }
-}
\ No newline at end of file
+
+    SECTION("destroys a range of objects, skipping null pointers")
+    {
+        counted_node::destroyed = 0;
+
+        shared<counted_node> nodes[] = {
+            shared<counted_node>::from_raw(new counted_node{}),
+            shared<counted_node>::from_raw(new counted_node{}),
+            shared<counted_node>::null(),
+            shared<counted_node>::from_raw(new counted_node{})
+        };
+
+        auto g = guard::unprotected();
+        REQUIRE(g.defer_destroy_range(std::begin(nodes), std::end(nodes)) == defer_status::ok);
+        REQUIRE(counted_node::destroyed == 3);
+    }
+
+    SECTION("destroys a pre-linked chain of objects")
+    {
+        counted_node::destroyed = 0;
+
+        auto* head = new counted_node{new counted_node{new counted_node{}}};
+
+        auto g = guard::unprotected();
+        auto const status = g.defer_destroy_chain(
+            shared<counted_node>::from_raw(head),
+            [](counted_node& n){ return shared<counted_node>::from_raw(n.next); });
+
+        REQUIRE(status == defer_status::ok);
+        REQUIRE(counted_node::destroyed == 3);
+    }
+
+    SECTION("defers a batch of functions across several bags")
+    {
+        auto x = 0ul;
+
+        auto c = collector{};
+        auto const h = c.register_handle();
+        {
+            auto batch = std::vector<deferred>{};
+            for (auto i = 0ul; i < 3*MAX_OBJECTS + 1; ++i)
+            {
+                batch.emplace_back([&x](){ ++x; });
+            }
+
+            auto g = h.pin();
+            REQUIRE(g.defer_batch(batch.data(), batch.data() + batch.size()) == defer_status::ok);
+            
+            // the full bags were sealed and handed to the global queue
+            REQUIRE(c.instance->pending() == 3);
+            g.flush();
+        }
+
+        for (auto i = 0; i < 8 && x < 3*MAX_OBJECTS + 1; ++i)
+        {
+            h.pin().flush();
+        }
+
+        REQUIRE(x == 3*MAX_OBJECTS + 1);
+    }
+
+    SECTION("destroys a range longer than a chunk under a pinned guard")
+    {
+        counted_node::destroyed = 0;
+
+        auto nodes = std::vector<shared<counted_node>>{};
+        nodes.reserve(100);
+        for (auto i = 0ul; i < 100; ++i)
+        {
+            auto const n = shared<counted_node>::from_raw(new counted_node{});
+            nodes.push_back(n);
+        }
+
+        auto c = collector{};
+        auto const h = c.register_handle();
+        {
+            auto g = h.pin();
+            REQUIRE(g.defer_destroy_range(nodes.begin(), nodes.end(), 100*64) == defer_status::ok);
+            g.flush();
+        }
+
+        for (auto i = 0; i < 8 && counted_node::destroyed < 100; ++i)
+        {
+            h.pin().flush();
+        }
+
+        REQUIRE(counted_node::destroyed == 100);
+        REQUIRE(c.unreclaimed_bytes() == 0);
+    }
+
+    SECTION("splits the bytes of a batch among the bags it fills")
+    {
+        auto c = collector{};
+        auto const h = c.register_handle();
+
+        auto batch = std::vector<deferred>{};
+        for (auto i = 0ul; i < 2*MAX_OBJECTS; ++i)
+        {
+            batch.emplace_back([](){});
+        }
+
+        auto g = h.pin();
+        REQUIRE(g.defer_batch(batch.data(), batch.data() + batch.size(), 2*MAX_OBJECTS*100) == defer_status::ok);
+
+        // only the first bag is sealed, with the bytes of its own functions
+        REQUIRE(c.unreclaimed_bytes() == MAX_OBJECTS*100);
+
+        g.flush();
+        REQUIRE(c.unreclaimed_bytes() == 2*MAX_OBJECTS*100);
+    }
+}
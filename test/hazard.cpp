@@ -0,0 +1,293 @@
+// test/hazard.cpp
+
+#include <catch2/catch.hpp>
+#include <epic/atomic.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+#include <epic/hp_collector.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // A node that counts how many of its kind have been destroyed.
+    struct counted_node
+    {
+        static inline std::atomic_ulong destroyed{0};
+
+        unsigned long value;
+        epic::atomic<counted_node> next;
+
+        explicit counted_node(unsigned long value_)
+            : value{value_}
+            , next{epic::atomic<counted_node>::null()} {}
+
+        ~counted_node()
+        {
+            ++destroyed;
+        }
+    };
+
+    // A Treiber stack written once against the guard API.
+    template <typename Collector>
+    class stack
+    {
+        epic::atomic<counted_node> head;
+
+    public:
+        stack() : head{epic::atomic<counted_node>::null()} {}
+
+        ~stack()
+        {
+            auto g = Collector::guard_type::unprotected();
+            while (pop(g)) {}
+        }
+
+        template <typename Guard>
+        auto push(unsigned long value, Guard& g) -> void
+        {
+            auto node = epic::shared<counted_node>::from_usize(
+                epic::pointable<counted_node>::init(value));
+
+            for (;;)
+            {
+                auto top = head.load(std::memory_order_relaxed, g);
+                node->next.store(top.clone(), std::memory_order_relaxed);
+                if (head.compare_and_set_weak(top, node, std::memory_order_release, g))
+                {
+                    return;
+                }
+            }
+        }
+
+        template <typename Guard>
+        auto pop(Guard& g) -> bool
+        {
+            for (;;)
+            {
+                auto top = head.load(std::memory_order_acquire, g);
+                if (top.is_null())
+                {
+                    return false;
+                }
+
+                auto next = top->next.load(std::memory_order_relaxed, g);
+                if (head.compare_and_set_weak(top, next, std::memory_order_acq_rel, g))
+                {
+                    g.defer_destroy(top.clone());
+                    return true;
+                }
+            }
+        }
+    };
+
+    template <typename Collector>
+    auto run_stack(Collector& c) -> void
+    {
+        constexpr static auto const THREADS = 4ul;
+        constexpr static auto const OPS     = 2000ul;
+
+        auto const before = counted_node::destroyed.load();
+        {
+            stack<Collector> s{};
+
+            auto threads = std::vector<std::thread>{};
+            for (auto i = 0ul; i < THREADS; ++i)
+            {
+                threads.emplace_back([&]
+                {
+                    auto const h = c.register_handle();
+                    for (auto n = 0ul; n < OPS; ++n)
+                    {
+                        auto g = h.pin();
+                        s.push(n, g);
+                        s.pop(g);
+                    }
+                });
+            }
+
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+        }
+
+        // Every node is eventually destroyed, exactly once.
+        c = Collector{};
+        REQUIRE(counted_node::destroyed.load() - before == THREADS*OPS);
+    }
+}
+
+TEST_CASE("epic::hp_collector")
+{
+    using namespace epic;
+
+    SECTION("a protected object is not dropped until its hazard is released")
+    {
+        auto c = hp_collector{};
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        auto a = atomic<counted_node>::make(1ul);
+        auto const before = counted_node::destroyed.load();
+        {
+            auto rg = reader.pin();
+            auto p = a.load(std::memory_order_acquire, rg);
+            REQUIRE(p->value == 1);
+
+            auto wg = writer.pin();
+            auto old = a.swap(shared<counted_node>::null(), std::memory_order_acq_rel, wg);
+            wg.defer_destroy(old.clone());
+
+            wg.flush();
+            REQUIRE(counted_node::destroyed.load() == before);
+            REQUIRE(writer.pending() == 1);
+            REQUIRE(p->value == 1);
+        }
+
+        writer.pin().flush();
+        REQUIRE(counted_node::destroyed.load() == before + 1);
+        REQUIRE(writer.pending() == 0);
+    }
+
+    SECTION("loads rotate through the hazard pointers")
+    {
+        auto c = hp_collector{};
+        auto const h = c.register_handle();
+
+        auto a = atomic<counted_node>::make(1ul);
+        auto const before = counted_node::destroyed.load();
+
+        auto g = h.pin();
+        auto p = a.load(std::memory_order_acquire, g);
+        g.defer_destroy(a.swap(shared<counted_node>::null(), std::memory_order_acq_rel, g).clone());
+
+        g.flush();
+        REQUIRE(counted_node::destroyed.load() == before);
+
+        // once SLOTS further loads were made, `p` is no longer protected
+        auto b = atomic<counted_node>::null();
+        for (auto i = 0ul; i < hazard_record::SLOTS; ++i)
+        {
+            b.load(std::memory_order_acquire, g);
+        }
+
+        g.flush();
+        REQUIRE(counted_node::destroyed.load() == before + 1);
+    }
+
+    SECTION("a held pointer stays protected across any number of loads")
+    {
+        auto c = hp_collector{};
+        auto const h = c.register_handle();
+
+        auto a = atomic<counted_node>::make(1ul);
+        auto const before = counted_node::destroyed.load();
+
+        auto g = h.pin();
+        auto p = a.load(std::memory_order_acquire, g);
+        {
+            auto const held = g.hold(p);
+            g.defer_destroy(a.swap(shared<counted_node>::null(), std::memory_order_acq_rel, g).clone());
+
+            auto b = atomic<counted_node>::null();
+            for (auto i = 0ul; i < 2*hazard_record::SLOTS; ++i)
+            {
+                b.load(std::memory_order_acquire, g);
+            }
+
+            g.flush();
+            REQUIRE(counted_node::destroyed.load() == before);
+            REQUIRE(p->value == 1);
+        }
+
+        g.flush();
+        REQUIRE(counted_node::destroyed.load() == before + 1);
+    }
+
+    SECTION("counts the protections dropped by reusing a hazard pointer")
+    {
+        auto c = hp_collector{};
+        auto const h = c.register_handle();
+
+        auto a = atomic<counted_node>::make(1ul);
+        {
+            auto g = h.pin();
+            for (auto i = 0ul; i < hazard_record::SLOTS; ++i)
+            {
+                a.load(std::memory_order_acquire, g);
+            }
+
+            REQUIRE(h.overwritten() == 0);
+
+            a.load(std::memory_order_acquire, g);
+            REQUIRE(h.overwritten() == 1);
+        }
+
+        // dropping the last guard releases every hazard pointer
+        auto g = h.pin();
+        a.load(std::memory_order_acquire, g);
+        REQUIRE(h.overwritten() == 1);
+
+        g.defer_destroy(a.swap(shared<counted_node>::null(), std::memory_order_acq_rel, g).clone());
+    }
+
+    SECTION("a dummy guard drops retired objects immediately")
+    {
+        auto a = atomic<counted_node>::make(1ul);
+        auto const before = counted_node::destroyed.load();
+
+        auto g = hp_guard::unprotected();
+        REQUIRE(g.is_dummy());
+        g.defer_destroy(a.load(std::memory_order_relaxed, g).clone());
+        REQUIRE(counted_node::destroyed.load() == before + 1);
+    }
+
+    SECTION("reuses the hazard records of dropped handles")
+    {
+        auto c = hp_collector{};
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto const h = c.register_handle();
+            auto g = h.pin();
+        }
+
+        REQUIRE(c.participants() == 1);
+    }
+
+    SECTION("objects still protected when a handle is dropped are adopted")
+    {
+        auto c = hp_collector{};
+        auto const reader = c.register_handle();
+
+        auto a = atomic<counted_node>::make(1ul);
+        auto const before = counted_node::destroyed.load();
+
+        auto rg = reader.pin();
+        auto p = a.load(std::memory_order_acquire, rg);
+        {
+            auto const writer = c.register_handle();
+            auto wg = writer.pin();
+            wg.defer_destroy(a.swap(shared<counted_node>::null(), std::memory_order_acq_rel, wg).clone());
+        }
+
+        REQUIRE(counted_node::destroyed.load() == before);
+        REQUIRE(p->value == 1);
+
+        // the next scan by any participant drops the orphan
+        rg = hp_guard{};
+        reader.pin().flush();
+        REQUIRE(counted_node::destroyed.load() == before + 1);
+    }
+
+    SECTION("the same data structure code runs under both schemes")
+    {
+        auto ebr = collector{};
+        run_stack(ebr);
+
+        auto hp = hp_collector{};
+        run_stack(hp);
+    }
+}
@@ -0,0 +1,237 @@
+// test/ibr.cpp
+
+#include <catch2/catch.hpp>
+#include <epic/atomic.hpp>
+#include <epic/ibr_collector.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    static std::atomic_ulong destroyed{0};
+
+    // A node stamped with its birth era.
+    struct stamped_node : epic::era_stamped
+    {
+        unsigned long value;
+        epic::atomic<stamped_node> next;
+
+        explicit stamped_node(unsigned long value_)
+            : value{value_}
+            , next{epic::atomic<stamped_node>::null()} {}
+
+        ~stamped_node()
+        {
+            ++destroyed;
+        }
+    };
+
+    // A node without an era header.
+    struct plain_node
+    {
+        unsigned long value;
+
+        explicit plain_node(unsigned long value_)
+            : value{value_} {}
+
+        ~plain_node()
+        {
+            ++destroyed;
+        }
+    };
+
+    // Retires the object stored in `a` under `g`.
+    template <typename T>
+    auto unlink(epic::atomic<T>& a, epic::ibr_guard& g) -> void
+    {
+        auto old = a.swap(epic::shared<T>::null(), std::memory_order_acq_rel, g);
+        g.defer_destroy(old.clone());
+    }
+}
+
+TEST_CASE("epic::ibr_collector")
+{
+    using namespace epic;
+
+    SECTION("objects are stamped with their birth era")
+    {
+        auto const era = era_clock().load();
+        auto a = atomic<stamped_node>::make(1ul);
+
+        auto g = ibr_guard::unprotected();
+        REQUIRE(a.load(std::memory_order_relaxed, g)->birth_era == era);
+        unlink(a, g);
+    }
+
+    SECTION("a reserved object is not dropped until the reservation ends")
+    {
+        auto c = ibr_collector{};
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        auto a = atomic<stamped_node>::make(1ul);
+        auto const before = destroyed.load();
+        {
+            auto rg = reader.pin();
+            auto p = a.load(std::memory_order_acquire, rg);
+
+            auto wg = writer.pin();
+            unlink(a, wg);
+            era_clock().fetch_add(1);
+
+            wg.flush();
+            REQUIRE(destroyed.load() == before);
+            REQUIRE(writer.pending() == 1);
+            REQUIRE(p->value == 1);
+        }
+
+        writer.pin().flush();
+        REQUIRE(destroyed.load() == before + 1);
+        REQUIRE(writer.pending() == 0);
+    }
+
+    SECTION("a stalled reader does not hold back younger objects")
+    {
+        auto c = ibr_collector{};
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        auto a = atomic<stamped_node>::make(1ul);
+        auto rg = reader.pin();
+        auto p = a.load(std::memory_order_acquire, rg);
+
+        era_clock().fetch_add(1);
+
+        auto const before = destroyed.load();
+        auto b = atomic<stamped_node>::make(2ul);
+        {
+            auto wg = writer.pin();
+            unlink(b, wg);
+        }
+
+        // a scan reserves the current era, like any other guard
+        era_clock().fetch_add(1);
+        writer.pin().flush();
+
+        REQUIRE(destroyed.load() == before + 1);
+        REQUIRE(p->value == 1);
+
+        rg = ibr_guard{};
+        auto wg = writer.pin();
+        unlink(a, wg);
+    }
+
+    SECTION("objects without an era header are reclaimed conservatively")
+    {
+        auto c = ibr_collector{};
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        auto rg = reader.pin();
+        era_clock().fetch_add(1);
+
+        auto const before = destroyed.load();
+        auto b = atomic<plain_node>::make(2ul);
+        {
+            auto wg = writer.pin();
+            unlink(b, wg);
+        }
+
+        era_clock().fetch_add(1);
+        writer.pin().flush();
+
+        // treated as born in era 0, it overlaps the stalled reservation
+        REQUIRE(destroyed.load() == before);
+
+        rg = ibr_guard{};
+        writer.pin().flush();
+        REQUIRE(destroyed.load() == before + 1);
+    }
+
+    SECTION("objects retired before a reservation are dropped")
+    {
+        auto c = ibr_collector{};
+        auto const reader = c.register_handle();
+        auto const writer = c.register_handle();
+
+        auto const before = destroyed.load();
+        auto a = atomic<stamped_node>::make(1ul);
+        {
+            auto wg = writer.pin();
+            unlink(a, wg);
+        }
+
+        era_clock().fetch_add(1);
+        auto rg = reader.pin();
+
+        writer.pin().flush();
+        REQUIRE(destroyed.load() == before + 1);
+    }
+
+    SECTION("a dummy guard drops retired objects immediately")
+    {
+        auto a = atomic<stamped_node>::make(1ul);
+        auto const before = destroyed.load();
+
+        auto g = ibr_guard::unprotected();
+        REQUIRE(g.is_dummy());
+        unlink(a, g);
+        REQUIRE(destroyed.load() == before + 1);
+    }
+
+    SECTION("reuses the era records of dropped handles")
+    {
+        auto c = ibr_collector{};
+        for (auto i = 0; i < 4; ++i)
+        {
+            auto const h = c.register_handle();
+            auto g = h.pin();
+        }
+
+        REQUIRE(c.participants() == 1);
+    }
+
+    SECTION("every object is dropped exactly once under contention")
+    {
+        constexpr static auto const THREADS = 4ul;
+        constexpr static auto const OPS     = 2000ul;
+
+        auto const before = destroyed.load();
+        {
+            auto c = ibr_collector{};
+            auto a = atomic<stamped_node>::null();
+
+            auto threads = std::vector<std::thread>{};
+            for (auto i = 0ul; i < THREADS; ++i)
+            {
+                threads.emplace_back([&]
+                {
+                    auto const h = c.register_handle();
+                    for (auto n = 0ul; n < OPS; ++n)
+                    {
+                        auto g = h.pin();
+                        auto node = shared<stamped_node>::from_usize(
+                            pointable<stamped_node>::init(n));
+                        auto old = a.swap(node, std::memory_order_acq_rel, g);
+                        if (!old.is_null())
+                        {
+                            g.defer_destroy(old.clone());
+                        }
+                    }
+                });
+            }
+
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+
+            auto g = ibr_guard::unprotected();
+            unlink(a, g);
+        }
+
+        REQUIRE(destroyed.load() - before == THREADS*OPS);
+    }
+}
@@ -0,0 +1,90 @@
+// test/local.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/local.hpp>
+#include <epic/global.hpp>
+#include <epic/local_handle.hpp>
+
+#include <memory>
+
+TEST_CASE("epic::local")
+{
+    using namespace epic;
+
+    SECTION("does not collect when no bags are pending")
+    {
+        REQUIRE(local::collect_period(0) == 0);
+    }
+
+    SECTION("collects more frequently as the backlog grows")
+    {
+        auto const small = local::collect_period(1);
+        auto const large = local::collect_period(8*global::COLLECT_STEPS);
+
+        REQUIRE(small == 128);
+        REQUIRE(large < small);
+        REQUIRE(local::collect_period(1ul << 40) == 1);
+    }
+
+    SECTION("collects eagerly once the byte threshold is crossed")
+    {
+        auto c = collector{};
+        c.set_byte_threshold(1 << 20);
+
+        auto const h = c.register_handle();
+
+        auto released = false;
+        {
+            auto g = h.pin();
+            g.defer([&released](){ released = true; }, 1 << 20);
+
+            // the bag was sealed while we are pinned, so it cannot expire yet
+            REQUIRE_FALSE(released);
+            REQUIRE(c.unreclaimed_bytes() == (1 << 20));
+        }
+
+        // the next pin sees the pressure and collects without
+        // waiting for the periodic collection to come around
+        {
+            auto g = h.pin();
+        }
+
+        REQUIRE(released);
+        REQUIRE(c.unreclaimed_bytes() == 0);
+    }
+
+    SECTION("trims the bag pools when the byte threshold is crossed")
+    {
+        auto c = collector{};
+        c.set_byte_threshold(1 << 20);
+
+        c.instance->recycle_bag(std::make_unique<bag>(), nullptr);
+        c.instance->recycle_bag(std::make_unique<bag>(), nullptr);
+        REQUIRE(c.instance->free_count.load() == 2);
+
+        auto const generation = c.instance->trim_generation.load();
+        auto const h = c.register_handle();
+        {
+            auto g = h.pin();
+            g.defer([](){}, 1 << 20);
+        }
+
+        // the shared pool is freed, and participants are asked to free theirs
+        REQUIRE(c.instance->trim_generation.load() == generation + 1);
+        REQUIRE(c.instance->free_count.load() == 0);
+    }
+
+    SECTION("accounts the bytes of a bag once it is sealed")
+    {
+        auto c = collector{};
+        auto const h = c.register_handle();
+
+        auto g = h.pin();
+        g.defer([](){}, 100);
+        REQUIRE(c.unreclaimed_bytes() == 0);
+
+        g.flush();
+        REQUIRE(c.unreclaimed_bytes() == 100);
+    }
+}
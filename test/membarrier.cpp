@@ -0,0 +1,60 @@
+// test/membarrier.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/collector.hpp>
+#include <epic/membarrier.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+
+TEST_CASE("epic::membarrier")
+{
+    using namespace epic;
+
+    SECTION("heavy barrier succeeds once the process is registered")
+    {
+        if (membarrier_register())
+        {
+            REQUIRE(membarrier_heavy());
+        }
+    }
+
+    SECTION("collectors default to symmetric fences")
+    {
+        auto c = collector{};
+        REQUIRE(c.get_fence_mode() == fence_mode::symmetric);
+    }
+
+    SECTION("asymmetric fences fall back when membarrier() is unavailable")
+    {
+        auto c = collector{fence_mode::asymmetric};
+
+        auto const expected = membarrier_register() 
+            ? fence_mode::asymmetric 
+            : fence_mode::symmetric;
+
+        REQUIRE(c.get_fence_mode() == expected);
+    }
+
+    SECTION("collectors with asymmetric fences reclaim garbage")
+    {
+        std::atomic_ulong x{};
+
+        auto c = collector{fence_mode::asymmetric};
+        auto h = c.register_handle();
+
+        {
+            auto g = h.pin();
+            g.defer([&x](){ x.fetch_add(1); });
+        }
+
+        for (auto i = 0; i < 1024 && x.load() == 0; ++i)
+        {
+            auto g = h.pin();
+            g.flush();
+        }
+
+        REQUIRE(x.load() == 1);
+    }
+}
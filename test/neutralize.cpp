@@ -0,0 +1,200 @@
+// test/neutralize.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/global.hpp>
+#include <epic/collector.hpp>
+#include <epic/neutralize.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("epic::neutralize")
+{
+    using namespace epic;
+    using namespace std::chrono_literals;
+
+    SECTION("runs the read phase once when nothing stalls")
+    {
+        auto c = collector{};
+        REQUIRE(c.enable_neutralization(1ms));
+
+        auto const h = c.register_handle();
+
+        auto calls = 0;
+        auto const r = restartable(h, [&calls](guard&){ return ++calls; });
+
+        REQUIRE(r == 1);
+        REQUIRE_FALSE(h.is_pinned());
+    }
+
+    SECTION("restarts a stalled read phase so that the epoch can advance")
+    {
+        auto c = collector{};
+        REQUIRE(c.enable_neutralization(1ms));
+
+        std::atomic_ulong attempts{0};
+        std::atomic_bool  done{false};
+
+        auto reader = std::thread{[&]()
+        {
+            auto const h = c.register_handle();
+            restartable(h, [&](guard&)
+            {
+                attempts.fetch_add(1);
+                while (!done.load())
+                {}
+            });
+        }};
+
+        while (0 == attempts.load())
+        {
+            std::this_thread::yield();
+        }
+
+        // the reader is pinned in the current epoch; one advance succeeds
+        auto const first = c.instance->try_advance();
+
+        // the next advance is held back by the reader until it is
+        // neutralized, after which it repins in the current epoch
+        auto advanced = first;
+        for (auto i = 0; i < 1000 && advanced == first; ++i)
+        {
+            std::this_thread::sleep_for(1ms);
+            advanced = c.instance->try_advance();
+        }
+
+        done.store(true);
+        reader.join();
+
+        REQUIRE(advanced != first);
+        REQUIRE(attempts.load() >= 2);
+    }
+
+    SECTION("signals a restartable straggler behind one that cannot be neutralized")
+    {
+        auto c = collector{};
+        REQUIRE(c.enable_neutralization(1ms));
+
+        std::atomic_bool  pinned{false};
+        std::atomic_ulong attempts{0};
+        std::atomic_bool  done{false};
+
+        // takes the first slot and stays pinned outside any read phase
+        auto blocker = std::thread{[&]()
+        {
+            auto const h = c.register_handle();
+            auto g = h.pin();
+            pinned.store(true);
+            while (!done.load())
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+        }};
+
+        while (!pinned.load())
+        {
+            std::this_thread::yield();
+        }
+
+        auto reader = std::thread{[&]()
+        {
+            auto const h = c.register_handle();
+            restartable(h, [&](guard&)
+            {
+                attempts.fetch_add(1);
+                while (!done.load() && attempts.load() < 2)
+                {}
+            });
+        }};
+
+        while (0 == attempts.load())
+        {
+            std::this_thread::yield();
+        }
+
+        c.instance->try_advance();
+        for (auto i = 0; i < 1000 && attempts.load() < 2; ++i)
+        {
+            std::this_thread::sleep_for(1ms);
+            c.instance->try_advance();
+        }
+
+        auto const restarted = attempts.load();
+
+        done.store(true);
+        reader.join();
+        blocker.join();
+
+        REQUIRE(restarted >= 2);
+    }
+
+    SECTION("a signal from one collector does not restart a read phase of another")
+    {
+        auto outer = collector{};
+        auto inner = collector{};
+        REQUIRE(outer.enable_neutralization(1ms));
+        REQUIRE(inner.enable_neutralization(1ms));
+
+        std::atomic_ulong attempts{0};
+        std::atomic_bool  done{false};
+
+        auto reader = std::thread{[&]()
+        {
+            auto const ho = outer.register_handle();
+            auto const hi = inner.register_handle();
+            restartable(ho, [&](guard&)
+            {
+                restartable(hi, [&](guard&)
+                {
+                    attempts.fetch_add(1);
+                    while (!done.load())
+                    {}
+                });
+            });
+        }};
+
+        while (0 == attempts.load())
+        {
+            std::this_thread::yield();
+        }
+
+        // the outer collector signals the reader, whose innermost
+        // read phase belongs to the inner collector
+        auto const first = outer.instance->try_advance();
+        for (auto i = 0; i < 20; ++i)
+        {
+            std::this_thread::sleep_for(1ms);
+            outer.instance->try_advance();
+        }
+
+        auto const restarted = attempts.load();
+
+        done.store(true);
+        reader.join();
+
+        REQUIRE(outer.instance->global_epoch.load(std::memory_order_relaxed) == first);
+        REQUIRE(restarted == 1);
+    }
+
+    SECTION("nested read phases are not neutralizable")
+    {
+        auto c = collector{};
+        REQUIRE(c.enable_neutralization(1ms));
+
+        auto const h = c.register_handle();
+        {
+            auto g = h.pin();
+            auto const cp = checkpoint{h};
+            REQUIRE(cp.is_neutralizable());
+        }
+
+        // an enclosing guard would be invalidated by a restart
+        auto outer = h.pin();
+        auto inner = h.pin();
+        auto const cp = checkpoint{h};
+        REQUIRE_FALSE(cp.is_neutralizable());
+    }
+}
@@ -0,0 +1,110 @@
+// test/qsbr.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/local.hpp>
+#include <epic/global.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+
+TEST_CASE("epic::collector::register_qsbr()")
+{
+    using namespace epic;
+
+    SECTION("an online participant is pinned without a guard")
+    {
+        auto c = collector{};
+        auto const h = c.register_qsbr();
+        REQUIRE(h.is_pinned());
+        REQUIRE(h.get_local()->is_qsbr());
+    }
+
+    SECTION("the epoch advances only past a quiescent participant")
+    {
+        auto c = collector{};
+        auto const h = c.register_qsbr();
+
+        auto const before = c.instance->try_advance();
+        REQUIRE(c.instance->try_advance() == before);
+
+        h.quiescent();
+        REQUIRE(c.instance->try_advance() == before.successor());
+    }
+
+    SECTION("pinning a guard does not move the participant")
+    {
+        auto c = collector{};
+        auto const h = c.register_qsbr();
+
+        auto const before = c.instance->try_advance();
+        {
+            auto g = h.pin();
+            REQUIRE(c.instance->try_advance() == before);
+        }
+
+        REQUIRE(h.is_pinned());
+        REQUIRE(c.instance->try_advance() == before);
+    }
+
+    SECTION("an offline participant does not hold back the epoch")
+    {
+        auto c = collector{};
+        auto const h = c.register_qsbr();
+
+        h.offline();
+        REQUIRE_FALSE(h.is_pinned());
+
+        auto const before = c.instance->try_advance();
+        REQUIRE(c.instance->try_advance() == before.successor());
+
+        // back online, it is pinned in the current epoch again
+        h.online();
+        REQUIRE(h.is_pinned());
+        auto const after = c.instance->try_advance();
+        REQUIRE(after == before.successor().successor());
+        REQUIRE(c.instance->try_advance() == after);
+    }
+
+    SECTION("qsbr and ordinary participants share a collector")
+    {
+        auto c = collector{};
+        auto const q = c.register_qsbr();
+        auto const h = c.register_handle();
+
+        auto x = std::atomic_int{0};
+        {
+            auto g = h.pin();
+            g.defer([&x](){ x.fetch_add(1); });
+            g.flush();
+        }
+
+        // the qsbr participant holds back the garbage...
+        for (auto i = 0; i < 4; ++i)
+        {
+            h.pin().flush();
+        }
+        REQUIRE(x.load() == 0);
+
+        // ...until it passes through enough quiescent states
+        for (auto i = 0; i < 4; ++i)
+        {
+            q.quiescent();
+            h.pin().flush();
+        }
+        REQUIRE(x.load() == 1);
+    }
+
+    SECTION("dropping the last handle takes the participant offline")
+    {
+        auto c = collector{};
+        auto const h = c.register_handle();
+        {
+            auto const q = c.register_qsbr();
+        }
+
+        auto const before = c.instance->try_advance();
+        REQUIRE(c.instance->try_advance() == before.successor());
+    }
+}
@@ -0,0 +1,101 @@
+// test/reclaimer.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("epic::reclaimer")
+{
+    using namespace epic;
+    using namespace std::chrono_literals;
+
+    SECTION("may be started and stopped via the collector")
+    {
+        auto c = collector{};
+        REQUIRE_FALSE(c.is_reclaimer_running());
+
+        REQUIRE(c.start_reclaimer(1ms));
+        REQUIRE(c.is_reclaimer_running());
+
+        // starting a running reclaimer is a no-op
+        REQUIRE_FALSE(c.start_reclaimer(1ms));
+
+        REQUIRE(c.stop_reclaimer());
+        REQUIRE_FALSE(c.is_reclaimer_running());
+
+        // stopping a stopped reclaimer is a no-op
+        REQUIRE_FALSE(c.stop_reclaimer());
+    }
+
+    SECTION("may be started and stopped concurrently")
+    {
+        auto c = collector{};
+
+        auto starter = std::thread{[&]()
+        {
+            for (auto i = 0; i < 200; ++i)
+            {
+                c.start_reclaimer(1ms);
+            }
+        }};
+
+        for (auto i = 0; i < 200; ++i)
+        {
+            c.stop_reclaimer();
+        }
+
+        starter.join();
+        c.stop_reclaimer();
+        REQUIRE_FALSE(c.is_reclaimer_running());
+    }
+
+    SECTION("reader-only handles never execute collection inline")
+    {
+        std::atomic_ulong x{};
+
+        auto c = collector{};
+        auto h = c.register_reader();
+
+        {
+            auto g = h.pin();
+            g.defer([&x](){ x.fetch_add(1); });
+        }
+
+        for (auto i = 0; i < 1024; ++i)
+        {
+            auto g = h.pin();
+            g.flush();
+        }
+
+        REQUIRE(x.load() == 0);
+    }
+
+    SECTION("collects garbage deferred by reader-only handles")
+    {
+        std::atomic_ulong x{};
+
+        auto c = collector{};
+        auto h = c.register_reader();
+
+        REQUIRE(c.start_reclaimer(1ms));
+
+        {
+            auto g = h.pin();
+            g.defer([&x](){ x.fetch_add(1); });
+            g.flush();
+        }
+
+        for (auto i = 0; i < 5000 && x.load() == 0; ++i)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+
+        REQUIRE(x.load() == 1);
+        REQUIRE(c.stop_reclaimer());
+    }
+}
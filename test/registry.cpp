@@ -0,0 +1,76 @@
+// test/registry.cpp
+
+#include <catch2/catch.hpp>
+#include <epic/registry.hpp>
+
+#include <set>
+
+TEST_CASE("epic::registry")
+{
+    using namespace epic;
+
+    SECTION("is empty on construction")
+    {
+        auto r = registry{};
+        REQUIRE(r.capacity() == 0);
+        REQUIRE(r.occupied() == 0);
+    }
+
+    SECTION("reuses released slots")
+    {
+        auto r = registry{};
+
+        auto const a = r.acquire();
+        auto const b = r.acquire();
+        REQUIRE(a != b);
+        REQUIRE(r.occupied() == 2);
+
+        r.release(a);
+        REQUIRE(r.occupied() == 1);
+        REQUIRE(r.acquire() == a);
+    }
+
+    SECTION("grows beyond a single chunk")
+    {
+        auto r = registry{};
+
+        auto indices = std::set<usize_t>{};
+        for (auto i = 0ul; i < registry::SLOTS_PER_CHUNK + 1; ++i)
+        {
+            indices.insert(r.acquire());
+        }
+
+        REQUIRE(indices.size() == registry::SLOTS_PER_CHUNK + 1);
+        REQUIRE(r.capacity() == 2*registry::SLOTS_PER_CHUNK);
+        REQUIRE(r.occupied() == registry::SLOTS_PER_CHUNK + 1);
+    }
+
+    SECTION("detects participants pinned in a different epoch")
+    {
+        auto r = registry{};
+
+        auto const e0 = epoch{};
+        auto const e1 = e0.successor();
+
+        auto const a = r.acquire();
+        auto const b = r.acquire();
+
+        // Unpinned participants never hold back the epoch.
+        REQUIRE(r.all_pinned_in(e1));
+
+        r.at(a).local_epoch.store(e1.pinned(), std::memory_order_relaxed);
+        REQUIRE(r.all_pinned_in(e1));
+
+        r.at(b).local_epoch.store(e0.pinned(), std::memory_order_relaxed);
+        REQUIRE_FALSE(r.all_pinned_in(e1));
+        auto const s = r.find_straggler(e1);
+        REQUIRE(s.slot == b);
+        REQUIRE(s.local_epoch == e0.pinned());
+
+        // Released slots are no longer scanned.
+        r.at(b).local_epoch.store(epoch{}, std::memory_order_relaxed);
+        r.release(b);
+        REQUIRE(r.all_pinned_in(e1));
+        REQUIRE(r.find_straggler(e1).slot == registry::NONE);
+    }
+}
@@ -0,0 +1,141 @@
+// test/stats.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/stats.hpp>
+#include <epic/global.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <string>
+#include <atomic>
+#include <thread>
+
+TEST_CASE("epic::stats")
+{
+    using namespace epic;
+
+    SECTION("a fresh collector reports its gauges")
+    {
+        auto c = collector{};
+        auto const h = c.register_handle();
+
+        auto const s = c.stats();
+        REQUIRE(s.enabled == STATS_ENABLED);
+        REQUIRE(s.pending_bags == 0);
+        REQUIRE(s.participants == 1);
+        REQUIRE(s.unreclaimed_bytes == 0);
+    }
+
+    SECTION("the global epoch gauge follows advances")
+    {
+        auto c = collector{};
+        auto const h = c.register_handle();
+
+        auto const before = c.stats().global_epoch;
+        c.instance->try_advance();
+        REQUIRE(c.stats().global_epoch == before + 1);
+    }
+
+    SECTION("counters track pins, deferreds, and bags")
+    {
+        auto c = collector{};
+        std::atomic_ulong x{};
+        {
+            auto const h = c.register_handle();
+            for (auto i = 0; i < 10; ++i)
+            {
+                auto outer = h.pin();
+                auto inner = h.pin();
+                outer.defer([&x]{ ++x; });
+            }
+        }
+
+        // the finalized participant's counters are kept
+        auto const s = c.stats();
+        if (STATS_ENABLED)
+        {
+            REQUIRE(s.pins >= 20);
+            REQUIRE(s.outermost_pins >= 10);
+            REQUIRE(s.pins > s.outermost_pins);
+            REQUIRE(s.deferreds_retired == 10);
+            REQUIRE(s.bags_pushed >= 1);
+            REQUIRE(s.bags_collected <= s.bags_pushed);
+            REQUIRE(s.advances <= s.advance_attempts);
+            REQUIRE(s.deferreds_executed == x.load());
+        }
+        else
+        {
+            REQUIRE(s.pins == 0);
+            REQUIRE(s.deferreds_retired == 0);
+        }
+    }
+
+    SECTION("snapshots never go backwards while participants come and go")
+    {
+        auto c = collector{};
+        auto stop = std::atomic_bool{false};
+
+        auto churn = std::thread{[&c, &stop]
+        {
+            while (!stop.load())
+            {
+                auto const h = c.register_handle();
+                auto g = h.pin();
+                g.defer([]{});
+            }
+        }};
+
+        auto last = c.stats();
+        for (auto i = 0; i < 1000; ++i)
+        {
+            auto const s = c.stats();
+            REQUIRE(s.pins >= last.pins);
+            REQUIRE(s.outermost_pins >= last.outermost_pins);
+            REQUIRE(s.deferreds_retired >= last.deferreds_retired);
+            REQUIRE(s.bags_pushed >= last.bags_pushed);
+            REQUIRE(s.bags_collected <= s.bags_pushed);
+            last = s;
+        }
+
+        stop.store(true);
+        churn.join();
+    }
+
+    SECTION("renders JSON")
+    {
+        auto s = collector_stats{};
+        s.enabled      = true;
+        s.pins         = 3;
+        s.pending_bags = 2;
+
+        auto const json = s.to_json();
+        REQUIRE(json.front() == '{');
+        REQUIRE(json.back() == '}');
+        REQUIRE(json.find("\"enabled\":true") != std::string::npos);
+        REQUIRE(json.find("\"pins_total\":3") != std::string::npos);
+        REQUIRE(json.find("\"pending_bags\":2") != std::string::npos);
+    }
+
+    SECTION("renders the Prometheus text format")
+    {
+        auto s = collector_stats{};
+        s.enabled  = true;
+        s.advances = 7;
+
+        auto const text = s.to_prometheus("app");
+        REQUIRE(text.find("# TYPE app_advances_total counter\n") != std::string::npos);
+        REQUIRE(text.find("app_advances_total 7\n") != std::string::npos);
+        REQUIRE(text.find("# TYPE app_global_epoch gauge\n") != std::string::npos);
+    }
+
+    SECTION("omits the counters if statistics are disabled")
+    {
+        auto s = collector_stats{};
+        s.enabled = false;
+
+        REQUIRE(s.to_json().find("pins_total") == std::string::npos);
+        REQUIRE(s.to_prometheus().find("epic_pins_total") == std::string::npos);
+        REQUIRE(s.to_prometheus().find("epic_participants 0\n") != std::string::npos);
+    }
+}
@@ -0,0 +1,120 @@
+// test/trace.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/trace.hpp>
+#include <epic/global.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    auto count_of(std::string const& haystack, std::string const& needle) -> std::size_t
+    {
+        auto n = 0ul;
+        for (auto i = haystack.find(needle); i != std::string::npos; i = haystack.find(needle, i + 1))
+        {
+            ++n;
+        }
+        return n;
+    }
+}
+
+TEST_CASE("epic::trace")
+{
+    using namespace epic;
+
+    clear_trace();
+
+    SECTION("the trace is a Chrome trace_event document")
+    {
+        auto const json = dump_trace();
+        REQUIRE(json.rfind("{\"traceEvents\":[", 0) == 0);
+        REQUIRE(json.back() == '}');
+    }
+
+    SECTION("records pins, seals, collections, and advances")
+    {
+        auto c = collector{};
+        {
+            auto const h = c.register_handle();
+            for (auto i = 0; i < 3; ++i)
+            {
+                auto g = h.pin();
+                g.defer([]{});
+                g.flush();
+            }
+
+            c.instance->try_advance();
+        }
+
+        auto const json = dump_trace();
+        if (TRACE_ENABLED)
+        {
+            // every outermost pin is matched by an unpin
+            REQUIRE(count_of(json, "\"ph\":\"B\"") >= 3);
+            REQUIRE(count_of(json, "\"ph\":\"B\"") == count_of(json, "\"ph\":\"E\""));
+            REQUIRE(count_of(json, "\"name\":\"seal\"") >= 3);
+            REQUIRE(count_of(json, "\"name\":\"advance\"") >= 1);
+            REQUIRE(count_of(json, "\"name\":\"collect\"") >= 1);
+        }
+        else
+        {
+            REQUIRE(json.find("\"ph\"") == std::string::npos);
+        }
+    }
+
+    SECTION("merges the rings of all threads, including exited ones")
+    {
+        auto c = collector{};
+
+        auto threads = std::vector<std::thread>{};
+        for (auto i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([&c]
+            {
+                auto const h = c.register_handle();
+                auto g = h.pin();
+            });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        // each thread pins at least once, and unpins as often
+        auto const json = dump_trace();
+        REQUIRE(count_of(json, "\"ph\":\"B\"") >= (TRACE_ENABLED ? 4 : 0));
+        REQUIRE(count_of(json, "\"ph\":\"B\"") == count_of(json, "\"ph\":\"E\""));
+
+        // clearing frees the exited threads' rings
+        clear_trace();
+        REQUIRE(count_of(dump_trace(), "\"ph\"") == 0);
+    }
+
+    SECTION("a full ring retains only the most recent events")
+    {
+        if (TRACE_ENABLED)
+        {
+            auto* ring = trace_ring::current();
+            REQUIRE(nullptr != ring);
+            for (auto i = 0ul; i < trace_ring::CAPACITY + 10; ++i)
+            {
+                ring->record(trace_kind::advance, trace_clock(), 0, i);
+            }
+
+            auto records = std::vector<trace_record>{};
+            ring->snapshot(records);
+            REQUIRE(records.size() == trace_ring::CAPACITY);
+            REQUIRE(records.front().arg == 10);
+            REQUIRE(records.back().arg == trace_ring::CAPACITY + 9);
+        }
+    }
+
+    clear_trace();
+}
@@ -0,0 +1,123 @@
+// test/watchdog.cpp
+
+#include <catch2/catch.hpp>
+
+#include <epic/global.hpp>
+#include <epic/registry.hpp>
+#include <epic/watchdog.hpp>
+#include <epic/collector.hpp>
+#include <epic/local_handle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("epic::watchdog")
+{
+    using namespace epic;
+    using namespace std::chrono_literals;
+
+    SECTION("is disarmed by default")
+    {
+        auto w = watchdog{};
+        REQUIRE_FALSE(w.is_armed());
+    }
+
+    SECTION("reports a participant that holds back the epoch, once")
+    {
+        auto c = collector{};
+
+        auto reports = 0ul;
+        auto last    = stall_report{};
+        c.set_stall_watchdog(10ms, [&](stall_report const& r)
+        {
+            ++reports;
+            last = r;
+        });
+
+        std::atomic_bool pinned{false};
+        std::atomic_bool release{false};
+        auto stalled_id = std::thread::id{};
+
+        auto reader = std::thread{[&]()
+        {
+            auto const h = c.register_handle();
+            auto g = h.pin();
+            pinned.store(true);
+
+            while (!release.load())
+            {
+                std::this_thread::sleep_for(1ms);
+            }
+        }};
+        stalled_id = reader.get_id();
+
+        while (!pinned.load())
+        {
+            std::this_thread::yield();
+        }
+
+        // the reader is pinned in the current epoch, so one advance
+        // succeeds; from then on, the reader holds back the epoch
+        auto const advanced = c.instance->try_advance();
+        REQUIRE(c.instance->try_advance() == advanced);
+        REQUIRE(reports == 0);
+
+        std::this_thread::sleep_for(20ms);
+        c.instance->try_advance();
+        c.instance->try_advance();
+
+        REQUIRE(reports == 1);
+        REQUIRE(last.thread == stalled_id);
+        REQUIRE(last.global_epoch == advanced);
+        REQUIRE(last.pinned_epoch != advanced);
+        REQUIRE(last.stalled_for >= 10ms);
+
+        release.store(true);
+        reader.join();
+
+        // with the reader gone, the epoch advances again
+        REQUIRE(c.instance->try_advance() != advanced);
+
+        c.clear_stall_watchdog();
+        REQUIRE_FALSE(c.instance->stall_watch.is_armed());
+    }
+
+    SECTION("does not report a straggler that unpinned after the scan")
+    {
+        auto r = registry{};
+        auto w = watchdog{};
+
+        auto reports = 0ul;
+        auto last    = stall_report{};
+        w.arm(1ns, [&](stall_report const& report)
+        {
+            ++reports;
+            last = report;
+        });
+        std::this_thread::sleep_for(1ms);
+
+        auto const e0 = epoch{};
+        auto const e1 = e0.successor();
+
+        auto const a = r.acquire();
+        r.at(a).owner.store(std::this_thread::get_id());
+        r.at(a).local_epoch.store(e0.pinned(), std::memory_order_relaxed);
+        auto const s = r.find_straggler(e1);
+
+        // the report is not consumed by a participant that has moved on
+        r.at(a).local_epoch.store(epoch{}, std::memory_order_relaxed);
+        w.on_stall(r, s, e1);
+        REQUIRE(reports == 0);
+
+        r.at(a).local_epoch.store(e0.pinned(), std::memory_order_relaxed);
+        w.on_stall(r, r.find_straggler(e1), e1);
+        REQUIRE(reports == 1);
+        REQUIRE(last.slot == a);
+        REQUIRE(last.thread == std::this_thread::get_id());
+        REQUIRE(last.pinned_epoch == e0);
+
+        r.at(a).local_epoch.store(epoch{}, std::memory_order_relaxed);
+        r.release(a);
+    }
+}